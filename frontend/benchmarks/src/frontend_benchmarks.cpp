@@ -0,0 +1,186 @@
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "input_reader.hpp"
+#include "output_sink.hpp"
+#include "profiler.hpp"
+#include "shape_classifier.hpp"
+#include "simulator.hpp"
+#include "translation_unit.hpp"
+
+using language::Input_reader;
+using language::Output_sink;
+using language::Translation_unit;
+
+namespace {
+
+// A program of the end-to-end tests and the numbers one run of it reads.
+struct Workload {
+    const char *name;
+    const char *program;
+    const char *input;
+};
+
+const Workload fibonacci{"fibonacci", "test_fibonachi/fibonachi.txt", "90\n"};
+const Workload bitwise{"bitwise", "test_bitwise_op/bitwise_op.txt", ""};
+
+// A directory of this process for the workload files, removed with them when
+// the process exits.
+class Temp_dir final {
+  private:
+    std::filesystem::path path_;
+
+  public:
+    Temp_dir()
+        : path_(std::filesystem::temp_directory_path() /
+                ("frontend_benchmarks_" + std::to_string(::getpid()))) {
+        std::filesystem::create_directories(path_);
+    }
+
+    Temp_dir(const Temp_dir &) = delete;
+    Temp_dir &operator=(const Temp_dir &) = delete;
+
+    ~Temp_dir() {
+        std::error_code error;
+        std::filesystem::remove_all(path_, error);
+    }
+
+    const std::filesystem::path &path() const noexcept { return path_; }
+};
+
+const std::filesystem::path &workload_dir() {
+    static const Temp_dir dir;
+    return dir.path();
+}
+
+struct Workload_files {
+    std::filesystem::path program;
+    std::filesystem::path input;
+};
+
+// Writes `copies` copies of the program one after another, and the input for
+// all of them, so that small programs take long enough to be timed apart from
+// opening the file.
+Workload_files write_workload(const Workload &workload, std::size_t copies) {
+    std::ifstream source(std::filesystem::path(BENCHMARK_PROGRAMS_DIR) /
+                         workload.program);
+    if (!source)
+        throw std::runtime_error(std::string("unable to open ") +
+                                 workload.program);
+    const std::string text{std::istreambuf_iterator<char>(source), {}};
+
+    const auto stem = workload_dir() / (std::string(workload.name) + "_" +
+                                        std::to_string(copies));
+    Workload_files files{stem.string() + ".txt", stem.string() + ".in"};
+
+    std::ofstream program(files.program);
+    std::ofstream input(files.input);
+    for (std::size_t i = 0; i < copies; ++i) {
+        program << text << '\n';
+        input << workload.input;
+    }
+    return files;
+}
+
+void parse(Translation_unit &unit) {
+    if (unit.parse() != 0 || unit.parser().error_collector.has_errors())
+        throw std::runtime_error("benchmark program failed to compile");
+}
+
+void lexer(benchmark::State &state, const Workload &workload) {
+    const auto files = write_workload(workload, state.range(0));
+    std::ostringstream errors;
+
+    std::uint64_t tokens = 0;
+    std::uint64_t bytes = 0;
+    for (auto _ : state) {
+        Translation_unit unit{files.program.string(), errors};
+        auto &scanner = unit.scanner();
+        while (scanner.yylex() != 0)
+            ++tokens;
+        bytes += unit.source().text().size();
+    }
+
+    state.SetBytesProcessed(bytes);
+    state.counters["tokens"] =
+        benchmark::Counter(tokens, benchmark::Counter::kIsRate);
+}
+
+void parser(benchmark::State &state, const Workload &workload) {
+    const auto files = write_workload(workload, state.range(0));
+    std::ostringstream errors;
+
+    std::uint64_t nodes = 0;
+    for (auto _ : state) {
+        Translation_unit unit{files.program.string(), errors};
+        parse(unit);
+        nodes += unit.parser().get_pool().node_count();
+    }
+
+    state.counters["nodes"] =
+        benchmark::Counter(nodes, benchmark::Counter::kIsRate);
+}
+
+void simulator(benchmark::State &state, const Workload &workload) {
+    const auto files = write_workload(workload, state.range(0));
+    std::ostringstream errors;
+    Translation_unit unit{files.program.string(), errors};
+    parse(unit);
+    auto &root = *unit.parser().get_root();
+    language::classify_shapes(root);
+
+    const int null_fd = ::open("/dev/null", O_WRONLY);
+    if (null_fd < 0)
+        throw std::runtime_error("unable to open /dev/null");
+    {
+        Output_sink output{null_fd, language::Flush_policy::Size,
+                           Output_sink::block_size};
+
+        // The Profiler counts the statements of one run; the timed runs use
+        // the plain Simulator, which does not count them.
+        std::uint64_t statements_per_run = 0;
+        {
+            Input_reader input{files.input.string()};
+            language::Profiler profiler{
+                output, input, language::Simulator::default_call_depth};
+            root.accept(profiler);
+            for (const auto &entry : profiler.get_entries())
+                statements_per_run += entry.second.count;
+        }
+
+        for (auto _ : state) {
+            Input_reader input{files.input.string()};
+            language::Simulator simulator{
+                output, input, language::Simulator::default_call_depth};
+            root.accept(simulator);
+        }
+
+        state.counters["statements"] =
+            benchmark::Counter(statements_per_run * state.iterations(),
+                               benchmark::Counter::kIsRate);
+    }
+    ::close(null_fd);
+}
+
+} // namespace
+
+// The argument is the number of copies of the program run back to back.
+BENCHMARK_CAPTURE(lexer, fibonacci, fibonacci)->Arg(1)->Arg(1024);
+BENCHMARK_CAPTURE(lexer, bitwise, bitwise)->Arg(1)->Arg(1024);
+BENCHMARK_CAPTURE(parser, fibonacci, fibonacci)->Arg(1)->Arg(1024);
+BENCHMARK_CAPTURE(parser, bitwise, bitwise)->Arg(1)->Arg(1024);
+BENCHMARK_CAPTURE(simulator, fibonacci, fibonacci)->Arg(1)->Arg(64);
+BENCHMARK_CAPTURE(simulator, bitwise, bitwise)->Arg(1)->Arg(64);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,51 @@
+#ifndef FRONTEND_INCLUDE_PROGRAM_CACHE_HPP
+#define FRONTEND_INCLUDE_PROGRAM_CACHE_HPP
+
+#include "flat_ast.hpp"
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+namespace language {
+
+enum class Cache_status { Hit, Miss, Stale, Corrupt };
+
+struct Cache_key final {
+    std::uint64_t source_hash;
+    std::uint64_t source_size;
+    bool optimized;
+};
+
+struct Cache_lookup final {
+    Cache_status status;
+    // Set on a hit, the arrays point into the mapped entry.
+    std::optional<Flat_ast> program;
+};
+
+// Compiled programs stored as flat ASTs, one file per source text and -O
+// setting. An entry is the fixed header followed by the flat AST arrays at
+// 8-byte aligned offsets, so loading maps the file and checks it without
+// copying anything. Entries written by another compiler version are stale
+// and get replaced by the next store.
+class Program_cache final {
+  private:
+    std::filesystem::path directory_;
+
+  public:
+    // Creates the directory when it does not exist.
+    explicit Program_cache(std::filesystem::path directory);
+
+    static Cache_key key(std::string_view source, bool optimized) noexcept;
+
+    std::filesystem::path entry_path(const Cache_key &key) const;
+
+    Cache_lookup load(const Cache_key &key) const;
+    // Writes a new file and renames it over the entry, so concurrent runs
+    // never map a partially written one.
+    void store(const Cache_key &key, const Flat_ast &program) const;
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_PROGRAM_CACHE_HPP
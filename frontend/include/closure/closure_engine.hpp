@@ -0,0 +1,82 @@
+#ifndef FRONTEND_INCLUDE_CLOSURE_ENGINE_HPP
+#define FRONTEND_INCLUDE_CLOSURE_ENGINE_HPP
+
+#include "input_reader.hpp"
+#include "node.hpp"
+#include "output_sink.hpp"
+#include <functional>
+#include <vector>
+
+namespace language {
+
+using Expr_closure = std::function<number_t()>;
+using Stmt_closure = std::function<void()>;
+
+// Compiled expression together with its shape, so that the parent node can
+// pick a closure specialized for variable and constant operands.
+struct Operand final {
+    enum class Shape { Constant, Slot, Closure };
+
+    Shape shape = Shape::Constant;
+    number_t value = 0;
+    number_t *slot = nullptr;
+    Expr_closure closure;
+
+    Expr_closure to_closure() const;
+};
+
+class Closure_compiler final : public ASTVisitor {
+  private:
+    number_t *slots_;
+    Output_sink &out_;
+    Input_reader &in_;
+    Operand operand_;
+    Stmt_closure stmt_;
+
+  public:
+    Closure_compiler(number_t *slots, Output_sink &out, Input_reader &in)
+        : slots_(slots), out_(out), in_(in) {}
+
+    Stmt_closure compile(Program &program);
+
+    void visit(Program &node) override;
+    void visit(Block_stmt &node) override;
+    void visit(Empty_stmt &node) override;
+    void visit(Assignment_stmt &node) override;
+    void visit(Input &node) override;
+    void visit(If_stmt &node) override;
+    void visit(While_stmt &node) override;
+    void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
+    void visit(Assignment_expr &node) override;
+    void visit(Binary_operator &node) override;
+    void visit(Unary_operator &node) override;
+    void visit(Number &node) override;
+    void visit(Variable &node) override;
+
+    void visit(Func &node) override;
+    void visit(Call &node) override;
+
+  private:
+    Operand compile_expression(Expression &expression);
+    Stmt_closure compile_statement(Statement &statement);
+    Stmt_closure compile_stmts(const StmtList &stmts);
+};
+
+class Closure_engine final {
+  private:
+    std::vector<number_t> slots_;
+    Stmt_closure program_;
+
+  public:
+    Closure_engine(Program &program, Output_sink &out, Input_reader &in)
+        : slots_(program.get_slot_count()),
+          program_(
+              Closure_compiler{slots_.data(), out, in}.compile(program)) {}
+
+    void run() const { program_(); }
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_CLOSURE_ENGINE_HPP
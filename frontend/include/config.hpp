@@ -1,9 +1,9 @@
 #ifndef FRONTEND_INCLUDE_CONFIG_HPP
 #define FRONTEND_INCLUDE_CONFIG_HPP
 
+#include <cstdint>
 #include <string>
 #include <string_view>
-#include <unordered_set>
 
 namespace language {
 
@@ -12,7 +12,8 @@ using number_t = int;
 using name_t_sv = std::string_view;
 using name_t = std::string;
 
-using nametable_t = std::unordered_set<name_t>;
+using slot_t = std::uint32_t;
+using symbol_id_t = std::uint32_t;
 
 class Program;
 
@@ -0,0 +1,72 @@
+#ifndef FRONTEND_INCLUDE_MEMO_TABLE_HPP
+#define FRONTEND_INCLUDE_MEMO_TABLE_HPP
+
+#include "config.hpp"
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+namespace language {
+
+enum class Memo_eviction {
+    Lru,  // a hit moves the entry to the front of its set
+    Fifo, // entries keep the order they were inserted in
+};
+
+// Results of calls to pure functions, keyed by the function id and the
+// arguments. The table is split into sets of four entries that fill one
+// cache line, newest first; inserting into a full set evicts its last entry.
+class Memo_table final {
+  public:
+    static constexpr std::size_t default_size = std::size_t{1} << 16;
+    // Calls with more arguments are not memoized.
+    static constexpr std::size_t max_args = 2;
+
+    struct Key final {
+        number_t func;
+        std::array<number_t, max_args> args;
+    };
+
+    struct Stats final {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t evictions = 0;
+    };
+
+  private:
+    static constexpr std::size_t ways = 4;
+
+    struct Entry final {
+        // 0 for an empty entry, function ids start at 1.
+        number_t func = 0;
+        std::array<number_t, max_args> args{};
+        number_t value = 0;
+    };
+
+    struct alignas(ways * sizeof(Entry)) Set final {
+        std::array<Entry, ways> entries;
+    };
+
+    std::vector<Set> sets_;
+    std::size_t set_mask_;
+    Memo_eviction eviction_;
+    Stats stats_;
+
+  public:
+    // Holds at least `size` entries, rounded up to a power of two.
+    Memo_table(std::size_t size, Memo_eviction eviction);
+
+    std::optional<number_t> find(const Key &key) noexcept;
+    void insert(const Key &key, number_t value) noexcept;
+
+    const Stats &get_stats() const noexcept { return stats_; }
+    std::size_t capacity() const noexcept { return sets_.size() * ways; }
+
+  private:
+    Set &set_of(const Key &key) noexcept;
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_MEMO_TABLE_HPP
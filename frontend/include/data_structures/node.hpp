@@ -2,12 +2,15 @@
 #define FRONTEND_INCLUDE_AST_HPP
 
 #include "config.hpp"
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <vector>
 
 namespace language {
 
+class Symbol_table;
+
 class Node;
 class Program;
 class Statement;
@@ -19,6 +22,7 @@ class Empty_stmt;
 class If_stmt;
 class While_stmt;
 class Print_stmt;
+class Return_stmt;
 class Number;
 class Variable;
 class Input;
@@ -40,6 +44,7 @@ class ASTVisitor {
     virtual void visit(If_stmt &node) = 0;
     virtual void visit(While_stmt &node) = 0;
     virtual void visit(Print_stmt &node) = 0;
+    virtual void visit(Return_stmt &node) = 0;
     virtual void visit(Binary_operator &node) = 0;
     virtual void visit(Unary_operator &node) = 0;
     virtual void visit(Func &node) = 0;
@@ -75,24 +80,58 @@ enum class Binary_operators {
 
 enum class Unary_operators { Neg, Plus, Not };
 
-class Statement : public Node {};
+// Operand layouts of a Binary_operator that the Simulator evaluates without
+// visiting the children. Assigned by Shape_classifier before execution.
+enum class Operand_shape { Generic, Var_const, Var_var };
+
+// Statements remember where they start in the source; statements made by the
+// optimizer have line 0.
+class Statement : public Node {
+  private:
+    std::uint32_t line_ = 0;
+    std::uint32_t column_ = 0;
+
+  public:
+    std::uint32_t get_line() const noexcept { return line_; }
+    std::uint32_t get_column() const noexcept { return column_; }
+    void set_position(std::uint32_t line, std::uint32_t column) noexcept {
+        line_ = line;
+        column_ = column;
+    }
+};
 class Expression : public Node {};
 
 using Statement_ptr = Statement *;
 using StmtList = std::vector<Statement_ptr>;
 using Expression_ptr = Expression *;
 using Variable_ptr = Variable *;
+using FuncList = std::vector<Func *>;
 
 class Program : public Node {
   private:
     StmtList stmts_;
+    slot_t slot_count_;
+    Symbol_table *symbols_;
+    FuncList functions_;
 
   public:
-    explicit Program(StmtList stmts) : stmts_(std::move(stmts)) {}
+    Program(StmtList stmts, slot_t slot_count, Symbol_table &symbols,
+            FuncList functions = {})
+        : stmts_(std::move(stmts)), slot_count_(slot_count),
+          symbols_(&symbols), functions_(std::move(functions)) {}
 
     const StmtList &get_stmts() const noexcept { return stmts_; }
     StmtList &get_stmts() noexcept { return stmts_; }
 
+    slot_t get_slot_count() const noexcept { return slot_count_; }
+    slot_t add_slot() noexcept { return slot_count_++; }
+
+    Symbol_table &get_symbols() noexcept { return *symbols_; }
+    const Symbol_table &get_symbols() const noexcept { return *symbols_; }
+
+    // Every function literal of the program, indexed by its id minus one.
+    const FuncList &get_functions() const noexcept { return functions_; }
+
     void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 };
 
@@ -118,6 +157,7 @@ class Assignment_stmt : public Statement {
   private:
     Variable_ptr variable_;
     Expression_ptr value_;
+    std::optional<number_t> increment_;
 
   public:
     Assignment_stmt(Variable_ptr variable, Expression_ptr value)
@@ -126,6 +166,15 @@ class Assignment_stmt : public Statement {
     const Variable_ptr get_variable() const noexcept { return variable_; }
     Expression &get_value() noexcept { return *value_; }
     const Expression &get_value() const noexcept { return *value_; }
+    void set_value(Expression_ptr value) noexcept { value_ = value; }
+
+    // Set for `x = x + c` and `x = x - c`, holds the signed step.
+    std::optional<number_t> get_increment() const noexcept {
+        return increment_;
+    }
+    void set_increment(std::optional<number_t> step) noexcept {
+        increment_ = step;
+    }
 
     void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 };
@@ -142,6 +191,7 @@ class Assignment_expr : public Expression {
     const Variable_ptr get_variable() const noexcept { return variable_; }
     Expression &get_value() noexcept { return *value_; }
     const Expression &get_value() const noexcept { return *value_; }
+    void set_value(Expression_ptr value) noexcept { value_ = value; }
 
     void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 };
@@ -158,6 +208,11 @@ class While_stmt : public Statement {
     Expression &get_condition() noexcept { return *condition_; }
     Statement &get_body() noexcept { return *body_; }
 
+    void set_condition(Expression_ptr condition) noexcept {
+        condition_ = condition;
+    }
+    void set_body(Statement_ptr body) noexcept { body_ = body; }
+
     void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 };
 
@@ -178,6 +233,16 @@ class If_stmt : public Statement {
     Statement &else_branch() noexcept { return *else_branch_; }
     bool contains_else_branch() const noexcept { return else_branch_; }
 
+    void set_condition(Expression_ptr condition) noexcept {
+        condition_ = condition;
+    }
+    void set_then_branch(Statement_ptr branch) noexcept {
+        then_branch_ = branch;
+    }
+    void set_else_branch(Statement_ptr branch) noexcept {
+        else_branch_ = branch;
+    }
+
     void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 };
 
@@ -195,32 +260,63 @@ class Print_stmt : public Statement {
 
     Expression &get_value() noexcept { return *value_; }
     const Expression &get_value() const noexcept { return *value_; }
+    void set_value(Expression_ptr value) noexcept { value_ = value; }
 
     void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 };
 
+class Return_stmt : public Statement {
+  private:
+    Expression_ptr value_;
+    Call *tail_call_ = nullptr;
+
+  public:
+    explicit Return_stmt(Expression_ptr value) : value_(value) {}
+
+    Expression &get_value() noexcept { return *value_; }
+    const Expression &get_value() const noexcept { return *value_; }
+    void set_value(Expression_ptr value) noexcept { value_ = value; }
+
+    // Set for `return f(...)`, whose call can reuse the returning frame.
+    Call *get_tail_call() const noexcept { return tail_call_; }
+    void set_tail_call(Call *call) noexcept { tail_call_ = call; }
+
+    void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
+};
+
+// A function literal. It evaluates to its id, which is never 0, and binds
+// the id to its name if it has one. Parameters take the first slots of the
+// frame, the locals of the body the rest.
 class Func : public Expression {
   public:
-    using ParamList = std::vector<name_t_sv>;
+    using ParamList = std::vector<symbol_id_t>;
 
   private:
-    std::optional<name_t_sv> func_name_;
+    number_t id_;
+    Variable_ptr name_;
     ParamList params_;
     Statement_ptr body_;
+    slot_t frame_size_;
+    bool pure_ = false;
 
   public:
-    Func(std::optional<name_t_sv> func_name, ParamList params,
-         Statement_ptr body)
-        : func_name_(func_name), params_(std::move(params)),
-          body_(std::move(body)) {}
+    Func(number_t id, Variable_ptr name, ParamList params, Statement_ptr body,
+         slot_t frame_size)
+        : id_(id), name_(name), params_(std::move(params)), body_(body),
+          frame_size_(frame_size) {}
 
-    bool has_name() const noexcept { return func_name_.has_value(); }
+    number_t get_id() const noexcept { return id_; }
 
-    std::optional<name_t_sv> get_func_name() const noexcept {
-        return func_name_;
-    }
+    bool has_name() const noexcept { return name_; }
+    std::optional<symbol_id_t> get_func_name() const noexcept;
+    Variable_ptr get_name_variable() const noexcept { return name_; }
 
     const ParamList &get_params() const noexcept { return params_; }
+    slot_t get_frame_size() const noexcept { return frame_size_; }
+
+    // Set for functions whose result depends only on their arguments.
+    bool is_pure() const noexcept { return pure_; }
+    void set_pure(bool pure) noexcept { pure_ = pure; }
 
     Statement &get_body() noexcept { return *body_; }
     const Statement &get_body() const noexcept { return *body_; }
@@ -242,6 +338,7 @@ class Call final : public Expression {
 
     Expression &get_target() noexcept { return *target_; }
     const Expression &get_target() const noexcept { return *target_; }
+    void set_target(Expression_ptr target) noexcept { target_ = target; }
 
     const ArgExprList &get_args() const noexcept { return args_; }
     ArgExprList &get_args() noexcept { return args_; }
@@ -254,6 +351,7 @@ class Binary_operator : public Expression {
     Binary_operators op_;
     Expression_ptr left_;
     Expression_ptr right_;
+    Operand_shape shape_ = Operand_shape::Generic;
 
   public:
     Binary_operator(Binary_operators op, Expression_ptr left,
@@ -266,6 +364,12 @@ class Binary_operator : public Expression {
     Expression &get_right() noexcept { return *right_; }
     const Expression &get_right() const noexcept { return *right_; }
 
+    void set_left(Expression_ptr left) noexcept { left_ = left; }
+    void set_right(Expression_ptr right) noexcept { right_ = right; }
+
+    Operand_shape get_shape() const noexcept { return shape_; }
+    void set_shape(Operand_shape shape) noexcept { shape_ = shape; }
+
     void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 };
 
@@ -281,6 +385,7 @@ class Unary_operator : public Expression {
     Unary_operators get_operator() const noexcept { return op_; }
     Expression &get_operand() noexcept { return *operand_; }
     const Expression &get_operand() const noexcept { return *operand_; }
+    void set_operand(Expression_ptr operand) noexcept { operand_ = operand; }
 
     void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 };
@@ -297,18 +402,35 @@ class Number : public Expression {
     void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 };
 
+// A local variable lives in the frame of the function it is declared in, any
+// other one in the global slots.
 class Variable : public Expression {
   private:
-    name_t_sv var_name_;
+    symbol_id_t symbol_;
+    slot_t slot_;
+    bool local_;
 
   public:
-    explicit Variable(name_t_sv var_name) : var_name_(var_name) {}
+    Variable(symbol_id_t symbol, slot_t slot, bool local = false)
+        : symbol_(symbol), slot_(slot), local_(local) {}
+
+    symbol_id_t get_symbol() const noexcept { return symbol_; }
+    slot_t get_slot() const noexcept { return slot_; }
+    bool is_local() const noexcept { return local_; }
 
-    name_t_sv get_name() const noexcept { return var_name_; }
+    bool same_storage(const Variable &other) const noexcept {
+        return slot_ == other.slot_ && local_ == other.local_;
+    }
 
     void accept(ASTVisitor &visitor) override { visitor.visit(*this); }
 };
 
+inline std::optional<symbol_id_t> Func::get_func_name() const noexcept {
+    if (!name_)
+        return std::nullopt;
+    return name_->get_symbol();
+}
+
 } // namespace language
 
 #endif // FRONTEND_INCLUDE_AST_HPP
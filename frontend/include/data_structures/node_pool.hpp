@@ -3,20 +3,86 @@
 
 #include "config.hpp"
 #include "node.hpp"
-#include <memory>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace language {
 
 class Node_pool final {
   public:
+    static constexpr std::size_t default_chunk_size = std::size_t{1} << 20;
+
+  private:
+    struct Chunk {
+        std::byte *data;
+        std::size_t size;
+        bool mapped;
+    };
+
+    std::vector<Chunk> chunks_;
+    std::vector<Node *> nodes_;
+    std::byte *cursor_ = nullptr;
+    std::byte *limit_ = nullptr;
+    std::size_t chunk_size_;
+    std::size_t bytes_used_ = 0;
+    bool use_huge_pages_;
+
+  public:
+    explicit Node_pool(bool use_huge_pages = false,
+                       std::size_t chunk_size = default_chunk_size)
+        : chunk_size_(chunk_size), use_huge_pages_(use_huge_pages) {}
+
+    Node_pool(const Node_pool &) = delete;
+    Node_pool &operator=(const Node_pool &) = delete;
+
+    ~Node_pool() { release(); }
+
     template <typename T, typename... Args> T *make(Args &&...args) {
-        data_.push_back(std::make_unique<T>(std::forward<Args>(args)...));
-        return static_cast<T *>(data_.back().get());
+        static_assert(std::is_base_of_v<Node, T>);
+
+        // Reserve before constructing so that push_back cannot throw and
+        // leak a constructed node, but keep the geometric growth.
+        if (nodes_.size() == nodes_.capacity())
+            nodes_.reserve(std::max<std::size_t>(64, nodes_.size() * 2));
+        void *memory = allocate(sizeof(T), alignof(T));
+        T *node = ::new (memory) T(std::forward<Args>(args)...);
+        nodes_.push_back(node);
+        return node;
     }
 
+    // Destroys every node and returns all chunks at once.
+    void release() noexcept;
+
+    std::size_t bytes_used() const noexcept { return bytes_used_; }
+    std::size_t bytes_reserved() const noexcept;
+    std::size_t chunk_count() const noexcept { return chunks_.size(); }
+    std::size_t node_count() const noexcept { return nodes_.size(); }
+
   private:
-    std::vector<std::unique_ptr<Node>> data_;
+    void *allocate(std::size_t size, std::size_t alignment) {
+        auto *memory = align_up(cursor_, alignment);
+        if (!memory || memory + size > limit_)
+            memory = align_up(grow(size + alignment), alignment);
+
+        cursor_ = memory + size;
+        bytes_used_ += size;
+        return memory;
+    }
+
+    static std::byte *align_up(std::byte *ptr, std::size_t alignment) {
+        const auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+        return reinterpret_cast<std::byte *>((addr + alignment - 1) &
+                                             ~(alignment - 1));
+    }
+
+    std::byte *grow(std::size_t min_size);
+    Chunk allocate_chunk(std::size_t size);
+    static void free_chunk(const Chunk &chunk) noexcept;
 };
 
 } // namespace language
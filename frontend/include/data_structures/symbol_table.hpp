@@ -0,0 +1,53 @@
+#ifndef FRONTEND_INCLUDE_SYMBOL_TABLE_HPP
+#define FRONTEND_INCLUDE_SYMBOL_TABLE_HPP
+
+#include "config.hpp"
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace language {
+
+// Interns identifiers. Every distinct name gets a dense id on first sight,
+// and its hash is computed once and kept with it, so later stages compare
+// and index names by id only.
+class Symbol_table final {
+  public:
+    static constexpr symbol_id_t no_symbol =
+        std::numeric_limits<symbol_id_t>::max();
+
+  private:
+    struct Symbol {
+        name_t_sv name;
+        std::size_t hash;
+    };
+
+    std::deque<name_t> names_;
+    std::vector<Symbol> symbols_;
+    // Open addressing with linear probing; the size is a power of two.
+    std::vector<symbol_id_t> buckets_;
+
+  public:
+    symbol_id_t intern(name_t_sv name);
+    std::optional<symbol_id_t> find(name_t_sv name) const noexcept;
+
+    name_t_sv name(symbol_id_t symbol) const noexcept {
+        return symbols_[symbol].name;
+    }
+    std::size_t hash(symbol_id_t symbol) const noexcept {
+        return symbols_[symbol].hash;
+    }
+
+    std::size_t size() const noexcept { return symbols_.size(); }
+
+  private:
+    std::size_t probe(name_t_sv name, std::size_t hash) const noexcept;
+    void rehash(std::size_t bucket_count);
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_SYMBOL_TABLE_HPP
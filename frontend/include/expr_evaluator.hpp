@@ -34,6 +34,7 @@ class Expression_evaluator final : public ASTVisitor {
     void visit(If_stmt &node) override;
     void visit(While_stmt &node) override;
     void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
 
     void visit(Func &node) override;
     void visit(Call &node) override;
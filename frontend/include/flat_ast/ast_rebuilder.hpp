@@ -0,0 +1,36 @@
+#ifndef FRONTEND_INCLUDE_AST_REBUILDER_HPP
+#define FRONTEND_INCLUDE_AST_REBUILDER_HPP
+
+#include "flat_ast.hpp"
+#include "node.hpp"
+#include "node_pool.hpp"
+#include "symbol_table.hpp"
+#include <vector>
+
+namespace language {
+
+// Turns a flat AST back into pool nodes for the engines that walk the tree.
+// Slot names are interned into `symbols` again, nothing is re-parsed.
+class Ast_rebuilder final {
+  private:
+    const Flat_ast &ast_;
+    Node_pool &pool_;
+    Symbol_table &symbols_;
+    std::vector<symbol_id_t> slot_symbols_;
+
+  public:
+    Ast_rebuilder(const Flat_ast &ast, Node_pool &pool, Symbol_table &symbols)
+        : ast_(ast), pool_(pool), symbols_(symbols) {}
+
+    Program &rebuild();
+
+  private:
+    Statement_ptr statement(node_id id);
+    Expression_ptr expression(node_id id);
+    StmtList statements(node_id id);
+    Variable_ptr variable(node_id id);
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_AST_REBUILDER_HPP
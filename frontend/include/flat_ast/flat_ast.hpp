@@ -0,0 +1,135 @@
+#ifndef FRONTEND_INCLUDE_FLAT_AST_HPP
+#define FRONTEND_INCLUDE_FLAT_AST_HPP
+
+#include "config.hpp"
+#include "node.hpp"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace language {
+
+enum class Node_kind : std::uint8_t {
+    Program,
+    Block_stmt,
+    Empty_stmt,
+    Assignment_stmt,
+    Assignment_expr,
+    If_stmt,
+    While_stmt,
+    Print_stmt,
+    Input,
+    Binary_operator,
+    Unary_operator,
+    Number,
+    Variable,
+};
+
+using node_id = std::uint32_t;
+
+// Structure-of-arrays AST: node i is described by kinds[i], ops[i],
+// first[i] and second[i]. Statement lists and if branches live in the
+// shared children array. Nodes are stored in pre-order, the root is node 0.
+//
+//   Program, Block_stmt         first: children offset, second: count
+//   Assignment_stmt/_expr       first: slot,  second: value
+//   If_stmt                     first: cond,  second: children offset of
+//                                             { then, else or no_node }
+//   While_stmt                  first: cond,  second: body
+//   Print_stmt                  first: value
+//   Binary_operator             first: left,  second: right
+//   Unary_operator              first: operand
+//   Number                      first: value
+//   Variable                    first: slot
+//
+// The arrays are views: an AST built in memory keeps its vectors alive through
+// `storage_`, one loaded from the program cache keeps the file mapping.
+class Flat_ast final {
+  public:
+    static constexpr node_id no_node = std::numeric_limits<node_id>::max();
+
+    struct Layout {
+        std::span<const Node_kind> kinds;
+        std::span<const std::uint8_t> ops;
+        std::span<const std::uint32_t> first;
+        std::span<const std::uint32_t> second;
+        std::span<const node_id> children;
+        // slot_count() + 1 offsets of the slot names in `names`.
+        std::span<const std::uint32_t> name_offsets;
+        std::string_view names;
+    };
+
+  private:
+    Layout layout_;
+    std::shared_ptr<const void> storage_;
+
+  public:
+    Flat_ast() = default;
+    Flat_ast(const Layout &layout, std::shared_ptr<const void> storage)
+        : layout_(layout), storage_(std::move(storage)) {}
+
+    const Layout &layout() const noexcept { return layout_; }
+
+    node_id root() const noexcept { return 0; }
+    std::size_t size() const noexcept { return layout_.kinds.size(); }
+    slot_t slot_count() const noexcept {
+        return layout_.name_offsets.empty() ? 0
+                                            : layout_.name_offsets.size() - 1;
+    }
+    name_t_sv slot_name(slot_t slot) const noexcept {
+        const auto begin = layout_.name_offsets[slot];
+        return layout_.names.substr(begin,
+                                    layout_.name_offsets[slot + 1] - begin);
+    }
+
+    Node_kind kind(node_id id) const noexcept { return layout_.kinds[id]; }
+
+    Binary_operators binary_operator(node_id id) const noexcept {
+        return static_cast<Binary_operators>(layout_.ops[id]);
+    }
+    Unary_operators unary_operator(node_id id) const noexcept {
+        return static_cast<Unary_operators>(layout_.ops[id]);
+    }
+
+    std::span<const node_id> stmts(node_id id) const noexcept {
+        return {layout_.children.data() + layout_.first[id],
+                layout_.second[id]};
+    }
+
+    slot_t slot(node_id id) const noexcept { return layout_.first[id]; }
+    number_t number(node_id id) const noexcept {
+        return static_cast<number_t>(layout_.first[id]);
+    }
+
+    node_id value(node_id id) const noexcept {
+        return layout_.kinds[id] == Node_kind::Print_stmt ? layout_.first[id]
+                                                          : layout_.second[id];
+    }
+
+    node_id condition(node_id id) const noexcept { return layout_.first[id]; }
+    node_id body(node_id id) const noexcept { return layout_.second[id]; }
+    node_id then_branch(node_id id) const noexcept {
+        return layout_.children[layout_.second[id]];
+    }
+    node_id else_branch(node_id id) const noexcept {
+        return layout_.children[layout_.second[id] + 1];
+    }
+
+    node_id left(node_id id) const noexcept { return layout_.first[id]; }
+    node_id right(node_id id) const noexcept { return layout_.second[id]; }
+    node_id operand(node_id id) const noexcept { return layout_.first[id]; }
+
+    // Bytes taken by the node arrays and the children array.
+    std::size_t bytes_used() const noexcept {
+        return size() * (sizeof(Node_kind) + sizeof(std::uint8_t) +
+                         2 * sizeof(std::uint32_t)) +
+               layout_.children.size() * sizeof(node_id);
+    }
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_FLAT_AST_HPP
@@ -0,0 +1,58 @@
+#ifndef FRONTEND_INCLUDE_FLAT_AST_BUILDER_HPP
+#define FRONTEND_INCLUDE_FLAT_AST_BUILDER_HPP
+
+#include "flat_ast.hpp"
+#include "node.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace language {
+
+class Flat_ast_builder final : public ASTVisitor {
+  private:
+    struct Arrays {
+        std::vector<Node_kind> kinds;
+        std::vector<std::uint8_t> ops;
+        std::vector<std::uint32_t> first;
+        std::vector<std::uint32_t> second;
+        std::vector<node_id> children;
+        std::vector<std::uint32_t> name_offsets;
+        std::vector<char> names;
+    };
+
+    Arrays arrays_;
+    std::vector<name_t_sv> slot_names_;
+    node_id result_ = Flat_ast::no_node;
+    const Symbol_table *symbols_ = nullptr;
+
+  public:
+    Flat_ast build(Program &program);
+
+    void visit(Program &node) override;
+    void visit(Block_stmt &node) override;
+    void visit(Empty_stmt &node) override;
+    void visit(Assignment_stmt &node) override;
+    void visit(Input &node) override;
+    void visit(If_stmt &node) override;
+    void visit(While_stmt &node) override;
+    void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
+    void visit(Assignment_expr &node) override;
+    void visit(Binary_operator &node) override;
+    void visit(Unary_operator &node) override;
+    void visit(Number &node) override;
+    void visit(Variable &node) override;
+
+    void visit(Func &node) override;
+    void visit(Call &node) override;
+
+  private:
+    node_id add_node(Node_kind kind, std::uint8_t op = 0);
+    node_id lower(Node &node);
+    void lower_stmts(node_id id, const StmtList &stmts);
+    void name_slot(const Variable &variable);
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_FLAT_AST_BUILDER_HPP
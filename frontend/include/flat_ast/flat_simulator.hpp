@@ -0,0 +1,31 @@
+#ifndef FRONTEND_INCLUDE_FLAT_SIMULATOR_HPP
+#define FRONTEND_INCLUDE_FLAT_SIMULATOR_HPP
+
+#include "flat_ast.hpp"
+#include "input_reader.hpp"
+#include "output_sink.hpp"
+#include <vector>
+
+namespace language {
+
+class Flat_simulator final {
+  private:
+    const Flat_ast &ast_;
+    std::vector<number_t> slots_;
+    Output_sink &out_;
+    Input_reader &in_;
+
+  public:
+    Flat_simulator(const Flat_ast &ast, Output_sink &out, Input_reader &in)
+        : ast_(ast), slots_(ast.slot_count()), out_(out), in_(in) {}
+
+    void run() { execute(ast_.root()); }
+
+  private:
+    void execute(node_id id);
+    number_t evaluate(node_id id);
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_FLAT_SIMULATOR_HPP
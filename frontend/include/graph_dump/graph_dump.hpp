@@ -1,19 +1,71 @@
 #ifndef INCLUDE_GRAPH_DUMP
 #define INCLUDE_GRAPH_DUMP
 
+#include "flat_ast.hpp"
 #include "node.hpp"
+#include "profiler.hpp"
+#include "symbol_table.hpp"
+#include <cstdint>
 #include <fstream>
+#include <string>
+#include <unordered_map>
 
 namespace language {
 
+// What the heat of a node is measured by: how often it ran, or its share of
+// the running time.
+enum class Heat_mode { Count, Time };
+
+// How hot every node of a profiled run was. Statements take their counts and
+// time from the Profiler, and conditions their counts; a block is as hot as
+// its hottest statement. Other expressions, and the time of conditions, are
+// inherited from the node they belong to, which bounds them from above:
+// short-circuited operands run less often.
+class Heat_overlay final {
+  public:
+    struct Heat final {
+        std::uint64_t count = 0;
+        // Share of the samples taken while the node was running, 0 to 1.
+        double time_share = 0;
+        bool inherited_count = false;
+        bool inherited_time = false;
+    };
+
+  private:
+    std::unordered_map<const Statement *, Heat> heat_;
+    std::unordered_map<const Expression *, std::uint64_t> conditions_;
+    std::uint64_t max_count_ = 0;
+    Heat_mode mode_;
+    bool prune_;
+
+  public:
+    Heat_overlay(const Profiler &profiler, Heat_mode mode, bool prune);
+
+    Heat heat_of(const Statement &stmt) const;
+    // Heat of an expression that is part of a node of heat `enclosing`.
+    Heat heat_of(const Expression &expr, Heat enclosing) const;
+    // Nodes that never ran are left out of the graph.
+    bool prunes() const noexcept { return prune_; }
+    // Graphviz colour of a node, from pale yellow for the coldest to red for
+    // the hottest, grey if it never ran.
+    std::string color(Heat heat) const;
+};
+
 class Graph_dump final : public ASTVisitor {
   private:
     std::ostream &gv_;
     const Node *parent_;
+    const Symbol_table &symbols_;
+    const Heat_overlay *overlay_;
+    Heat_overlay::Heat heat_;
 
   public:
-    Graph_dump(std::ostream &gv, const Node *parent)
-        : gv_(gv), parent_(parent) {}
+    Graph_dump(std::ostream &gv, const Node *parent,
+               const Symbol_table &symbols,
+               const Heat_overlay *overlay = nullptr,
+               Heat_overlay::Heat heat = {})
+        : gv_(gv), parent_(parent), symbols_(symbols), overlay_(overlay),
+          heat_(heat) {}
 
     void visit(Program &node) override;
     void visit(Block_stmt &node) override;
@@ -23,6 +75,7 @@ class Graph_dump final : public ASTVisitor {
     void visit(If_stmt &node) override;
     void visit(While_stmt &node) override;
     void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
     void visit(Assignment_expr &node) override;
     void visit(Binary_operator &node) override;
     void visit(Unary_operator &node) override;
@@ -36,21 +89,30 @@ class Graph_dump final : public ASTVisitor {
     void emit_edge(const Node *from, const Node *to) {
         gv_ << "    node_" << from << " -> node_" << to << ";\n";
     }
+
+    // Fill colour of the node: its type colour, or its heat with an overlay.
+    std::string fill(const char *type_color) const;
+    std::string heat_label() const;
+    // Dumps a child of `from` with its own heat.
+    void descend(const Node &from, Node &to);
 };
 
-inline void graph_dump(std::ostream &gv, Node &root) {
+inline void graph_dump(std::ostream &gv, Program &root,
+                       const Heat_overlay *overlay = nullptr) {
     gv << "digraph G {\n"
        << "    rankdir=TB;\n"
        << "    node [style=filled, fontname=\"Helvetica\", fontcolor=darkblue, "
        << "fillcolor=peachpuff, color=\"#252A34\", penwidth=2.5];\n"
        << "    bgcolor=\"lemonchiffon\";\n\n";
 
-    Graph_dump visitor{gv, nullptr};
+    Graph_dump visitor{gv, nullptr, root.get_symbols(), overlay, {1, 1.0}};
     root.accept(visitor);
 
     gv << "\n}\n";
 }
 
+void graph_dump(std::ostream &gv, const Flat_ast &ast);
+
 } // namespace language
 
 #endif // INCLUDE_GRAPH_DUMP
\ No newline at end of file
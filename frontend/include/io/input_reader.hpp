@@ -0,0 +1,54 @@
+#ifndef FRONTEND_INCLUDE_IO_INPUT_READER_HPP
+#define FRONTEND_INCLUDE_IO_INPUT_READER_HPP
+
+#include "config.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace language {
+
+// Reads the whitespace separated numbers consumed by `?`. Regular files are
+// mapped into memory, pipes and terminals are read in large blocks.
+// Running out of input or a token that is not a number throws.
+class Input_reader final {
+  public:
+    static constexpr std::size_t block_size = 64 * 1024;
+
+  private:
+    int fd_;
+    bool owns_fd_ = false;
+
+    void *map_ = nullptr;
+    std::size_t map_size_ = 0;
+
+    std::vector<char> buffer_;
+    bool eof_ = false;
+
+    const char *pos_ = nullptr;
+    const char *end_ = nullptr;
+    std::size_t count_ = 0; // numbers read so far
+
+  public:
+    // Does not take ownership of fd.
+    explicit Input_reader(int fd);
+    explicit Input_reader(const std::string &path);
+    ~Input_reader();
+
+    Input_reader(const Input_reader &) = delete;
+    Input_reader &operator=(const Input_reader &) = delete;
+
+    number_t read_number();
+
+  private:
+    void init();
+    bool skip_whitespace();
+    // Moves the unread bytes to the front of the buffer and appends the
+    // next block. Returns false at end of input.
+    bool refill();
+    [[noreturn]] void fail(const std::string &what) const;
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_IO_INPUT_READER_HPP
@@ -0,0 +1,81 @@
+#ifndef FRONTEND_INCLUDE_IO_OUTPUT_SINK_HPP
+#define FRONTEND_INCLUDE_IO_OUTPUT_SINK_HPP
+
+#include "config.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace language {
+
+enum class Flush_policy {
+    Exit, // only when the sink is destroyed or the program traps
+    Line, // after every printed value
+    Size, // whenever the buffered output reaches the threshold
+};
+
+// Buffers printed values in fixed-size blocks and writes them to a file
+// descriptor with writev. The sink that was created last is also flushed
+// when the program is killed by SIGFPE (division by zero).
+class Output_sink final {
+  public:
+    static constexpr std::size_t block_size = 64 * 1024;
+
+  private:
+    int fd_;
+    Flush_policy policy_;
+    std::size_t threshold_;
+
+    struct Block final {
+        std::unique_ptr<char[]> data;
+        std::size_t size = 0;
+    };
+
+    std::vector<Block> blocks_;
+    std::size_t current_ = 0; // block being filled
+    std::size_t buffered_ = 0;
+
+    Output_sink *previous_ = nullptr;
+
+  public:
+    Output_sink(int fd, Flush_policy policy,
+                std::size_t threshold = block_size);
+    ~Output_sink();
+
+    Output_sink(const Output_sink &) = delete;
+    Output_sink &operator=(const Output_sink &) = delete;
+
+    // Line when fd refers to a terminal, Size otherwise.
+    static Flush_policy default_policy(int fd) noexcept;
+
+    void print(number_t value) {
+        reserve_line();
+
+        Block &block = blocks_[current_];
+        char *const begin = block.data.get() + block.size;
+        char *end = format(begin, value);
+        *end++ = '\n';
+
+        const auto size = static_cast<std::size_t>(end - begin);
+        block.size += size;
+        buffered_ += size;
+
+        if (policy_ == Flush_policy::Line ||
+            (policy_ == Flush_policy::Size && buffered_ >= threshold_))
+            flush();
+    }
+
+    void flush();
+
+    // Writes the buffered output without throwing or allocating, usable
+    // from a signal handler. Returns false on a write error.
+    bool write_buffered() noexcept;
+
+  private:
+    void reserve_line();
+    static char *format(char *out, number_t value) noexcept;
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_IO_OUTPUT_SINK_HPP
@@ -0,0 +1,88 @@
+#ifndef FRONTEND_INCLUDE_JIT_COMPILER_HPP
+#define FRONTEND_INCLUDE_JIT_COMPILER_HPP
+
+#include "input_reader.hpp"
+#include "node.hpp"
+#include "output_sink.hpp"
+#include "x86_64_emitter.hpp"
+#include <csetjmp>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <vector>
+
+namespace language {
+
+// Thrown when the program uses a node the JIT cannot compile, the caller is
+// expected to fall back to the Simulator.
+class Jit_unsupported : public std::runtime_error {
+  public:
+    using std::runtime_error::runtime_error;
+};
+
+struct Jit_runtime final {
+    Input_reader *in = nullptr;
+    Output_sink *out = nullptr;
+    // Exceptions cannot unwind through the generated code: helpers store
+    // them here and longjmp back to Jit_program::run, which rethrows.
+    std::exception_ptr error;
+    std::jmp_buf abort;
+};
+
+class Jit_program final {
+  private:
+    void *code_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<number_t> slots_;
+    Jit_runtime runtime_;
+
+  public:
+    Jit_program(const std::vector<std::uint8_t> &code, slot_t slot_count,
+                Output_sink &out, Input_reader &in);
+    ~Jit_program();
+
+    Jit_program(const Jit_program &) = delete;
+    Jit_program &operator=(const Jit_program &) = delete;
+
+    void run();
+};
+
+class Jit_compiler final : public ASTVisitor {
+  private:
+    X86_64_emitter emitter_;
+    std::size_t depth_ = 0;
+    std::size_t max_depth_ = 0;
+
+  public:
+    static bool is_supported() noexcept;
+
+    std::vector<std::uint8_t> compile(Program &program);
+
+    void visit(Program &node) override;
+    void visit(Block_stmt &node) override;
+    void visit(Empty_stmt &node) override;
+    void visit(Assignment_stmt &node) override;
+    void visit(Input &node) override;
+    void visit(If_stmt &node) override;
+    void visit(While_stmt &node) override;
+    void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
+    void visit(Assignment_expr &node) override;
+    void visit(Binary_operator &node) override;
+    void visit(Unary_operator &node) override;
+    void visit(Number &node) override;
+    void visit(Variable &node) override;
+
+    void visit(Func &node) override;
+    void visit(Call &node) override;
+
+  private:
+    void apply_ecx(Binary_operators op);
+    bool apply_imm(Binary_operators op, number_t value);
+    bool apply_slot(Binary_operators op, slot_t slot);
+    void compare(X86_64_emitter::Condition cond);
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_JIT_COMPILER_HPP
@@ -0,0 +1,83 @@
+#ifndef FRONTEND_INCLUDE_JIT_X86_64_EMITTER_HPP
+#define FRONTEND_INCLUDE_JIT_X86_64_EMITTER_HPP
+
+#include "config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+
+namespace language {
+
+// Minimal x86-64 machine code emitter. Expressions are evaluated into eax,
+// ecx and edx are scratch registers, rbx holds the variables array, r12 the
+// runtime context and temporaries are spilled to [rsp + 8 * depth].
+class X86_64_emitter final {
+  public:
+    enum class Alu : std::uint8_t { Add, Or, And, Sub, Xor, Cmp };
+    enum class Condition : std::uint8_t {
+        Eq,
+        Neq,
+        Less,
+        LessEq,
+        Greater,
+        GreaterEq
+    };
+
+    using label_t = std::size_t;
+
+  private:
+    std::vector<std::uint8_t> code_;
+
+  public:
+    const std::vector<std::uint8_t> &code() const noexcept { return code_; }
+    label_t here() const noexcept { return code_.size(); }
+
+    // Frame size is patched once the number of temporaries is known.
+    label_t prologue();
+    void epilogue(label_t frame_patch, std::int32_t frame_size);
+
+    void mov_eax_imm(number_t value);
+    void load_slot(slot_t slot);
+    void store_slot(slot_t slot);
+    void load_temp(std::size_t depth);
+    void store_temp(std::size_t depth);
+    void mov_ecx_eax();
+    void mov_eax_ecx();
+
+    void alu_ecx(Alu op);
+    void alu_imm(Alu op, number_t value);
+    void alu_slot(Alu op, slot_t slot);
+    void imul_ecx();
+    void imul_imm(number_t value);
+    void imul_slot(slot_t slot);
+    void idiv_ecx();
+    void mov_eax_edx();
+    void neg_eax();
+
+    void test_eax();
+    void test_ecx();
+    void setcc_eax(Condition cond);
+    void setcc_ecx(Condition cond);
+    void and_al_cl();
+    void or_al_cl();
+    void movzx_eax_al();
+
+    // Calls helper(context, eax) following the System V calling convention.
+    void call_helper(const void *helper, bool pass_eax);
+
+    label_t jmp();
+    label_t jz();
+    label_t jnz();
+    void patch_jump(label_t jump, label_t target);
+
+  private:
+    void emit(std::initializer_list<std::uint8_t> bytes);
+    void emit_imm32(std::uint32_t value);
+    void emit_imm64(std::uint64_t value);
+    void patch_imm32(std::size_t at, std::uint32_t value);
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_JIT_X86_64_EMITTER_HPP
@@ -0,0 +1,37 @@
+#ifndef FRONTEND_INCLUDE_OPTIMIZER_AST_WALKER_HPP
+#define FRONTEND_INCLUDE_OPTIMIZER_AST_WALKER_HPP
+
+#include "node.hpp"
+
+namespace language {
+
+// Visits every node of a subtree in evaluation order, descending into the
+// bodies of function literals. Analyses override the visits they care about
+// and call the base version to keep walking.
+class AST_walker : public ASTVisitor {
+  protected:
+    virtual void enter(Node &node) {}
+
+  public:
+    void visit(Program &node) override;
+    void visit(Block_stmt &node) override;
+    void visit(Empty_stmt &node) override;
+    void visit(Assignment_stmt &node) override;
+    void visit(Input &node) override;
+    void visit(If_stmt &node) override;
+    void visit(While_stmt &node) override;
+    void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
+    void visit(Assignment_expr &node) override;
+    void visit(Binary_operator &node) override;
+    void visit(Unary_operator &node) override;
+    void visit(Number &node) override;
+    void visit(Variable &node) override;
+
+    void visit(Func &node) override;
+    void visit(Call &node) override;
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_OPTIMIZER_AST_WALKER_HPP
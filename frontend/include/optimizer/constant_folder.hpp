@@ -0,0 +1,62 @@
+#ifndef FRONTEND_INCLUDE_OPTIMIZER_CONSTANT_FOLDER_HPP
+#define FRONTEND_INCLUDE_OPTIMIZER_CONSTANT_FOLDER_HPP
+
+#include "node.hpp"
+#include "node_pool.hpp"
+#include <optional>
+#include <vector>
+
+namespace language {
+
+// Result of a binary operator on constants, or nullopt when the operation
+// would trap at runtime (division by zero, INT_MIN / -1) and must be kept.
+std::optional<number_t> fold_binary(Binary_operators op, number_t lhs,
+                                    number_t rhs) noexcept;
+number_t fold_unary(Unary_operators op, number_t value) noexcept;
+
+// Folds constant subexpressions and propagates constants assigned to
+// variables through straight-line code.
+class Constant_folder final : public ASTVisitor {
+  private:
+    using facts_t = std::vector<std::optional<number_t>>;
+
+    Node_pool &pool_;
+    slot_t slot_count_ = 0;
+    facts_t facts_;
+    Expression_ptr result_ = nullptr;
+    std::size_t folded_ = 0;
+
+  public:
+    explicit Constant_folder(Node_pool &pool) : pool_(pool) {}
+
+    void run(Program &program);
+
+    std::size_t folded_count() const noexcept { return folded_; }
+
+    void visit(Program &node) override;
+    void visit(Block_stmt &node) override;
+    void visit(Empty_stmt &node) override;
+    void visit(Assignment_stmt &node) override;
+    void visit(Input &node) override;
+    void visit(If_stmt &node) override;
+    void visit(While_stmt &node) override;
+    void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
+    void visit(Assignment_expr &node) override;
+    void visit(Binary_operator &node) override;
+    void visit(Unary_operator &node) override;
+    void visit(Number &node) override;
+    void visit(Variable &node) override;
+
+    void visit(Func &node) override;
+    void visit(Call &node) override;
+
+  private:
+    Expression_ptr fold(Expression &expression);
+    Expression_ptr make_number(number_t value);
+    void kill(const std::vector<bool> &written);
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_OPTIMIZER_CONSTANT_FOLDER_HPP
@@ -0,0 +1,58 @@
+#ifndef FRONTEND_INCLUDE_OPTIMIZER_DEAD_CODE_ELIMINATOR_HPP
+#define FRONTEND_INCLUDE_OPTIMIZER_DEAD_CODE_ELIMINATOR_HPP
+
+#include "node.hpp"
+#include "node_pool.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace language {
+
+std::size_t count_nodes(Node &node);
+
+// True when evaluating the expression can neither change the program state
+// nor trap: no input, calls, nested assignments or possibly zero divisors.
+bool is_pure(Expression &expression);
+
+// Removes branches with constant conditions, while(0) loops, pure stores to
+// variables that are never read, and empty statements and blocks.
+class Dead_code_eliminator final : public ASTVisitor {
+  private:
+    Node_pool &pool_;
+    std::vector<bool> read_;
+    Statement_ptr result_ = nullptr;
+
+  public:
+    explicit Dead_code_eliminator(Node_pool &pool) : pool_(pool) {}
+
+    // Returns the number of nodes removed from the program.
+    std::size_t run(Program &program);
+
+    void visit(Program &node) override;
+    void visit(Block_stmt &node) override;
+    void visit(Empty_stmt &node) override;
+    void visit(Assignment_stmt &node) override;
+    void visit(Input &node) override;
+    void visit(If_stmt &node) override;
+    void visit(While_stmt &node) override;
+    void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
+    void visit(Assignment_expr &node) override;
+    void visit(Binary_operator &node) override;
+    void visit(Unary_operator &node) override;
+    void visit(Number &node) override;
+    void visit(Variable &node) override;
+
+    void visit(Func &node) override;
+    void visit(Call &node) override;
+
+  private:
+    // Returns the replacement of the statement, nullptr if it is removed.
+    Statement_ptr eliminate(Statement &stmt);
+    void eliminate(StmtList &stmts);
+    Statement_ptr eliminate_or_empty(Statement &stmt);
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_OPTIMIZER_DEAD_CODE_ELIMINATOR_HPP
@@ -0,0 +1,91 @@
+#ifndef FRONTEND_INCLUDE_OPTIMIZER_LOOP_INVARIANT_MOVER_HPP
+#define FRONTEND_INCLUDE_OPTIMIZER_LOOP_INVARIANT_MOVER_HPP
+
+#include "node.hpp"
+#include "node_pool.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace language {
+
+// Replaces the maximal pure subexpressions of a loop that read no variable
+// written by the loop with temporaries, and collects the assignments that
+// initialize those temporaries.
+class Invariant_hoister final : public ASTVisitor {
+  private:
+    Node_pool &pool_;
+    Program &program_;
+    const std::vector<bool> &written_;
+    StmtList preheader_;
+
+  public:
+    Invariant_hoister(Node_pool &pool, Program &program,
+                      const std::vector<bool> &written)
+        : pool_(pool), program_(program), written_(written) {}
+
+    StmtList &get_preheader() noexcept { return preheader_; }
+
+    void visit(Program &node) override;
+    void visit(Block_stmt &node) override;
+    void visit(Empty_stmt &node) override;
+    void visit(Assignment_stmt &node) override;
+    void visit(Input &node) override;
+    void visit(If_stmt &node) override;
+    void visit(While_stmt &node) override;
+    void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
+    void visit(Assignment_expr &node) override;
+    void visit(Binary_operator &node) override;
+    void visit(Unary_operator &node) override;
+    void visit(Number &node) override;
+    void visit(Variable &node) override;
+
+    void visit(Func &node) override;
+    void visit(Call &node) override;
+
+  private:
+    Expression_ptr hoist(Expression &expression);
+    bool is_invariant(Expression &expression) const;
+};
+
+// Moves loop-invariant computations in front of the loops. Outer loops are
+// processed first, so an expression invariant in several nested loops is
+// hoisted once, in front of the outermost of them.
+class Loop_invariant_mover final : public ASTVisitor {
+  private:
+    Node_pool &pool_;
+    Program *program_ = nullptr;
+    Statement_ptr result_ = nullptr;
+    std::size_t hoisted_ = 0;
+
+  public:
+    explicit Loop_invariant_mover(Node_pool &pool) : pool_(pool) {}
+
+    // Returns the number of hoisted expressions.
+    std::size_t run(Program &program);
+
+    void visit(Program &node) override;
+    void visit(Block_stmt &node) override;
+    void visit(Empty_stmt &node) override;
+    void visit(Assignment_stmt &node) override;
+    void visit(Input &node) override;
+    void visit(If_stmt &node) override;
+    void visit(While_stmt &node) override;
+    void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
+    void visit(Assignment_expr &node) override;
+    void visit(Binary_operator &node) override;
+    void visit(Unary_operator &node) override;
+    void visit(Number &node) override;
+    void visit(Variable &node) override;
+
+    void visit(Func &node) override;
+    void visit(Call &node) override;
+
+  private:
+    Statement_ptr move(Statement &stmt);
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_OPTIMIZER_LOOP_INVARIANT_MOVER_HPP
@@ -0,0 +1,20 @@
+#ifndef FRONTEND_INCLUDE_OPTIMIZER_HPP
+#define FRONTEND_INCLUDE_OPTIMIZER_HPP
+
+#include "node.hpp"
+#include "node_pool.hpp"
+
+namespace language {
+
+struct Optimization_stats final {
+    std::size_t folded_nodes = 0;
+    std::size_t removed_nodes = 0;
+    std::size_t hoisted_expressions = 0;
+};
+
+// Runs the AST optimization passes enabled by -O.
+Optimization_stats optimize(Program &program, Node_pool &pool);
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_OPTIMIZER_HPP
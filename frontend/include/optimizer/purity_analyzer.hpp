@@ -0,0 +1,19 @@
+#ifndef FRONTEND_INCLUDE_OPTIMIZER_PURITY_ANALYZER_HPP
+#define FRONTEND_INCLUDE_OPTIMIZER_PURITY_ANALYZER_HPP
+
+#include "node.hpp"
+#include <cstddef>
+
+namespace language {
+
+// Marks the functions whose result depends only on their arguments: their
+// bodies read no input, print nothing, use no variable outside their frame
+// and define no functions, and every function they call is pure as well.
+// A callee is only known when it is called through a global variable that
+// holds the same function wherever the program assigns it. Returns the
+// number of pure functions.
+std::size_t mark_pure_functions(Program &program);
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_OPTIMIZER_PURITY_ANALYZER_HPP
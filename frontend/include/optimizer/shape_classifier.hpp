@@ -0,0 +1,29 @@
+#ifndef FRONTEND_INCLUDE_OPTIMIZER_SHAPE_CLASSIFIER_HPP
+#define FRONTEND_INCLUDE_OPTIMIZER_SHAPE_CLASSIFIER_HPP
+
+#include "ast_walker.hpp"
+#include "node.hpp"
+
+namespace language {
+
+// Tags binary operators over variable and constant leaves, `x = x +- c`
+// assignments and returns of calls so that the Simulator can take its fast
+// evaluation paths.
+// Must run after the last pass that rewrites the tree.
+class Shape_classifier final : public AST_walker {
+  public:
+    using AST_walker::visit;
+
+    void visit(Assignment_stmt &node) override;
+    void visit(Return_stmt &node) override;
+    void visit(Binary_operator &node) override;
+};
+
+inline void classify_shapes(Program &program) {
+    Shape_classifier classifier;
+    program.accept(classifier);
+}
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_OPTIMIZER_SHAPE_CLASSIFIER_HPP
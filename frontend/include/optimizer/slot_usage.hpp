@@ -0,0 +1,55 @@
+#ifndef FRONTEND_INCLUDE_OPTIMIZER_SLOT_USAGE_HPP
+#define FRONTEND_INCLUDE_OPTIMIZER_SLOT_USAGE_HPP
+
+#include "ast_walker.hpp"
+#include "node.hpp"
+#include <vector>
+
+namespace language {
+
+// Collects the slots read and assigned anywhere inside a subtree, including
+// the bodies of function literals.
+class Slot_usage_collector final : public AST_walker {
+  private:
+    std::vector<bool> read_;
+    std::vector<bool> written_;
+    bool has_calls_ = false;
+
+  public:
+    explicit Slot_usage_collector(slot_t slot_count)
+        : read_(slot_count, false), written_(slot_count, false) {}
+
+    const std::vector<bool> &get_read() const noexcept { return read_; }
+    const std::vector<bool> &get_written() const noexcept { return written_; }
+    // A callee may read and assign any variable.
+    bool has_calls() const noexcept { return has_calls_; }
+
+    using AST_walker::visit;
+
+    void visit(Assignment_stmt &node) override {
+        written_[node.get_variable()->get_slot()] = true;
+        AST_walker::visit(node);
+    }
+
+    void visit(Assignment_expr &node) override {
+        written_[node.get_variable()->get_slot()] = true;
+        AST_walker::visit(node);
+    }
+
+    void visit(Variable &node) override { read_[node.get_slot()] = true; }
+
+    void visit(Call &node) override {
+        has_calls_ = true;
+        AST_walker::visit(node);
+    }
+};
+
+inline std::vector<bool> collect_read_slots(Node &node, slot_t slot_count) {
+    Slot_usage_collector collector{slot_count};
+    node.accept(collector);
+    return collector.get_read();
+}
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_OPTIMIZER_SLOT_USAGE_HPP
@@ -0,0 +1,55 @@
+#ifndef FRONTEND_INCLUDE_OPTIONS_HPP
+#define FRONTEND_INCLUDE_OPTIONS_HPP
+
+#include "graph_dump.hpp"
+#include "memo_table.hpp"
+#include "output_sink.hpp"
+#include "simulator.hpp"
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace language {
+
+enum class Engine { Simulator, Vm, Flat, Closure, Jit };
+
+struct Options final {
+    // A single program unless `check` is set.
+    std::vector<std::string> program_files;
+    // Numbers for `?` are read from stdin when empty.
+    std::string input_file;
+    Engine engine = Engine::Simulator;
+    bool use_huge_pages = false;
+    bool arena_stats = false;
+    bool optimize = false;
+    bool optimizer_stats = false;
+    bool lex_only = false;
+    bool check = false;
+    // Compiled programs are not cached when empty.
+    std::string cache_dir;
+    bool cache_stats = false;
+    // Threads used by `check`; 0 means one per hardware thread.
+    std::size_t jobs = 0;
+    // Chosen from the kind of stdout when not given.
+    std::optional<Flush_policy> flush_policy;
+    std::size_t flush_size = Output_sink::block_size;
+    std::size_t max_call_depth = Simulator::default_call_depth;
+    // Calls to pure functions are not memoized when 0.
+    std::size_t memo_size = Memo_table::default_size;
+    Memo_eviction memo_eviction = Memo_eviction::Lru;
+    bool memo_stats = false;
+    // Runs the program under the Profiler and prints its report to stderr.
+    bool profile = false;
+    // Colours the graph dump by execution heat; only builds with GRAPH_DUMP
+    // dump the graph.
+    std::optional<Heat_mode> dump_heat;
+    // Leaves nodes that never ran out of the heat-coloured graph dump.
+    bool dump_prune = false;
+};
+
+Options parse_options(int argc, const char **argv);
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_OPTIONS_HPP
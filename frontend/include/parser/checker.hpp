@@ -0,0 +1,29 @@
+#ifndef FRONTEND_INCLUDE_CHECKER_HPP
+#define FRONTEND_INCLUDE_CHECKER_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace language {
+
+struct Check_result final {
+    bool ok = false;
+    // Lexer messages and diagnostics, formatted as a single-file run would
+    // print them.
+    std::string output;
+};
+
+// Lexes and parses one program, resolving its variables, without running it.
+Check_result check_program(const std::string &program_file,
+                           bool use_huge_pages = false);
+
+// Checks the programs on `jobs` threads. Results are in the order of
+// `program_files` regardless of which thread finished first.
+std::vector<Check_result>
+check_programs(const std::vector<std::string> &program_files,
+               std::size_t jobs, bool use_huge_pages = false);
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_CHECKER_HPP
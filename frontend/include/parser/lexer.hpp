@@ -2,7 +2,25 @@
 #define FRONTEND_INCLUDE_LEXER_HPP
 
 #include "parser.hpp"
+
+#ifdef SIMD_LEXER
+
+#include "simd_lexer.hpp"
+
+namespace language {
+
+class Lexer final : public Simd_lexer {
+  public:
+    using Simd_lexer::Simd_lexer;
+};
+
+} // namespace language
+
+#else
+
 #include <fstream>
+#include <iostream>
+#include <string_view>
 
 #ifndef yyFlexLexer
 #include <FlexLexer.h>
@@ -11,22 +29,43 @@
 namespace language {
 
 class Lexer final : public yyFlexLexer {
+  private:
+    // The text being read from `in`. Token text is taken from it rather than
+    // from the Flex buffer, which is reused as the input is consumed.
+    std::string_view source_;
+    std::size_t consumed_ = 0;
+    std::ostream *errors_ = &std::cerr;
+
   public:
     int yylineno = 1;
     int yycolumn = 1;
 
-    Lexer(std::istream *in, std::ostream *out) : yyFlexLexer(in, out) {}
+    Lexer(std::istream *in, std::ostream *out, std::string_view source = {})
+        : yyFlexLexer(in, out), source_(source) {}
+
+    void set_error_stream(std::ostream &errors) noexcept { errors_ = &errors; }
 
     int get_line() const noexcept { return yylineno; }
 
     int get_column() const noexcept { return yycolumn; }
     int get_yyleng() const noexcept { return yyleng; }
 
+    std::string_view get_text() const noexcept {
+        const auto length = static_cast<std::size_t>(yyleng);
+        if (source_.empty())
+            return {YYText(), length};
+        return source_.substr(consumed_ - length, length);
+    }
+
     int process_if() const noexcept { return yy::parser::token::TOK_IF; }
     int process_else() const noexcept { return yy::parser::token::TOK_ELSE; }
     int process_while() const noexcept { return yy::parser::token::TOK_WHILE; }
     int process_print() const noexcept { return yy::parser::token::TOK_PRINT; }
     int process_input() const noexcept { return yy::parser::token::TOK_INPUT; }
+    int process_func() const noexcept { return yy::parser::token::TOK_FUNC; }
+    int process_return() const noexcept {
+        return yy::parser::token::TOK_RETURN;
+    }
     int process_plus() const noexcept { return yy::parser::token::TOK_PLUS; }
     int process_minus() const noexcept { return yy::parser::token::TOK_MINUS; }
     int process_mul() const noexcept { return yy::parser::token::TOK_MUL; }
@@ -74,6 +113,8 @@ class Lexer final : public yyFlexLexer {
     int process_semicolon() const noexcept {
         return yy::parser::token::TOK_SEMICOLON;
     }
+    int process_comma() const noexcept { return yy::parser::token::TOK_COMMA; }
+    int process_colon() const noexcept { return yy::parser::token::TOK_COLON; }
     int process_id() const noexcept { return yy::parser::token::TOK_ID; }
     int process_number() const noexcept {
         return yy::parser::token::TOK_NUMBER;
@@ -84,4 +125,6 @@ class Lexer final : public yyFlexLexer {
 
 } // namespace language
 
+#endif // SIMD_LEXER
+
 #endif // FRONTEND_INCLUDE_LEXER_HPP
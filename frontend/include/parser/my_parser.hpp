@@ -5,6 +5,8 @@
 #include "error_collector.hpp"
 #include "lexer.hpp"
 #include "parser.hpp"
+#include "source_file.hpp"
+#include "symbol_table.hpp"
 
 namespace language {
 
@@ -13,30 +15,23 @@ class My_parser final : public yy::parser {
     Lexer *scanner_;
     Node_pool pool_;
     program_ptr root_ = nullptr;
-    std::vector<std::string> source_lines_;
 
   public:
     Error_collector error_collector;
+    Symbol_table symbols;
     Scope scopes;
+    // Function literals in the order they were parsed.
+    FuncList functions;
 
-    My_parser(Lexer *scanner, const std::string &program_file)
+    My_parser(Lexer *scanner, const Source_file &source,
+              bool use_huge_pages = false)
         : yy::parser(scanner, pool_, root_, this), scanner_(scanner),
-          error_collector(program_file) {
-        read_source(program_file);
-    }
+          pool_(use_huge_pages), error_collector(source) {}
 
     program_ptr get_root() const noexcept { return root_; }
 
-    void read_source(std::string_view file_name) {
-        std::ifstream input_file(std::string{file_name});
-        std::string line;
-        while (std::getline(input_file, line))
-            source_lines_.push_back(line);
-    }
-
-    std::string_view get_line_content(const int num_line) const {
-        return source_lines_[num_line - 1];
-    }
+    Node_pool &get_pool() noexcept { return pool_; }
+    const Node_pool &get_pool() const noexcept { return pool_; }
 };
 
 } // namespace language
@@ -2,69 +2,139 @@
 #define FRONTEND_INCLUDE_SCOPE_HPP
 
 #include "config.hpp"
-#include <ranges>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
 #include <stdexcept>
-#include <string>
-#include <string_view>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
 namespace language {
 
+// Where a variable lives: a global slot or a slot of the current function's
+// frame.
+struct Slot_ref final {
+    slot_t slot;
+    bool local;
+};
+
+// Names are never shadowed: a name declared in an outer block is reused by
+// inner ones. So the visible variables form a single set of symbol ids, and
+// leaving a block only has to forget the ids it declared.
+//
+// Function bodies are the exception. Their parameters shadow any outer name,
+// and they cannot see the locals of an enclosing function, which are gone by
+// the time a nested function is called; globals stay visible, even those
+// an enclosing function hides with a local of the same name.
 class Scope final {
   private:
-    std::vector<nametable_t> scopes_;
-    std::vector<nametable_t> archived_;
+    static constexpr slot_t no_slot = std::numeric_limits<slot_t>::max();
+
+    struct Binding {
+        slot_t slot = no_slot;
+        // 0 for globals, otherwise the nesting level of the function.
+        std::uint32_t function = 0;
+        // Slot of the global a local binding hides, seen by nested functions.
+        slot_t global = no_slot;
+    };
+
+    // Binding of every symbol, indexed by symbol id.
+    std::vector<Binding> bindings_;
+    // Declared symbols with the binding they hid, restored on pop().
+    std::vector<std::pair<symbol_id_t, Binding>> declared_;
+    std::vector<std::size_t> scope_starts_;
+    // Frame sizes of the functions being parsed, innermost last.
+    std::vector<slot_t> frames_;
+    slot_t n_slots_ = 0;
 
   public:
     Scope() {
         push(); // add global scope
     }
 
-    void push(nametable_t nametable = {}) {
-        scopes_.emplace_back(std::move(nametable));
-    }
+    void push() { scope_starts_.push_back(declared_.size()); }
 
     void pop() {
-        if (scopes_.empty()) {
+        if (scope_starts_.empty()) {
             throw std::underflow_error("pop() called with empty scope stack");
         }
-        archived_.push_back(std::move(scopes_.back()));
-        scopes_.pop_back();
+        const auto start = scope_starts_.back();
+        for (auto i = declared_.size(); i-- > start;)
+            bindings_[declared_[i].first] = declared_[i].second;
+        declared_.resize(start);
+        scope_starts_.pop_back();
+    }
+
+    void push_function() {
+        frames_.push_back(0);
+        push();
+    }
+
+    // Returns the frame size of the function.
+    slot_t pop_function() {
+        if (frames_.empty()) {
+            throw std::underflow_error(
+                "pop_function() called outside of a function");
+        }
+        pop();
+        const auto frame_size = frames_.back();
+        frames_.pop_back();
+        return frame_size;
     }
 
-    name_t_sv lookup(name_t_sv var_name) const {
-        if (scopes_.empty())
-            return {};
+    bool in_function() const noexcept { return !frames_.empty(); }
 
-        const std::string key(var_name);
+    std::optional<Slot_ref> lookup(symbol_id_t symbol) const noexcept {
+        if (symbol >= bindings_.size())
+            return std::nullopt;
+        const auto binding = bindings_[symbol];
+        if (binding.slot == no_slot)
+            return std::nullopt;
+        if (binding.function != 0 && binding.function != frames_.size()) {
+            if (binding.global == no_slot)
+                return std::nullopt;
+            return Slot_ref{binding.global, false};
+        }
+        return Slot_ref{binding.slot, binding.function != 0};
+    }
 
-        for (const auto &scope : scopes_ | std::views::reverse) {
-            if (const auto &f = scope.find(key); f != scope.end()) {
-                return std::string_view(*f);
-            }
+    bool find(symbol_id_t symbol) const noexcept {
+        return lookup(symbol).has_value();
+    }
+
+    Slot_ref add_variable(symbol_id_t symbol) {
+        if (auto existing = lookup(symbol)) {
+            return *existing;
         }
-        return {};
+        return declare(symbol);
     }
 
-    bool find(name_t_sv var_name) const { return !lookup(var_name).empty(); }
+    Slot_ref add_parameter(symbol_id_t symbol) { return declare(symbol); }
+
+    slot_t slot_count() const noexcept { return n_slots_; }
 
-    name_t_sv add_variable(name_t_sv var_name) {
-        if (scopes_.empty()) {
+  private:
+    Slot_ref declare(symbol_id_t symbol) {
+        if (scope_starts_.empty()) {
             throw std::underflow_error(
                 "add_variable() called with empty scope stack");
         }
 
-        if (auto existing = lookup(var_name); !existing.empty()) {
-            return existing;
-        }
+        if (symbol >= bindings_.size())
+            bindings_.resize(symbol + 1);
+        declared_.emplace_back(symbol, bindings_[symbol]);
 
-        auto [it, inserted] = scopes_.back().emplace(std::string(var_name));
-        return std::string_view(*it);
+        const auto hidden = bindings_[symbol];
+        const std::uint32_t function = frames_.size();
+        const auto slot = function ? frames_.back()++ : n_slots_++;
+        bindings_[symbol] = {slot, function,
+                             hidden.function == 0 ? hidden.slot
+                                                  : hidden.global};
+        return {slot, function != 0};
     }
 };
 
 } // namespace language
 
-#endif // FRONTEND_INCLUDE_UTILS_HPP
+#endif // FRONTEND_INCLUDE_SCOPE_HPP
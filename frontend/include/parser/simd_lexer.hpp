@@ -0,0 +1,52 @@
+#ifndef FRONTEND_INCLUDE_SIMD_LEXER_HPP
+#define FRONTEND_INCLUDE_SIMD_LEXER_HPP
+
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+
+namespace language {
+
+// Hand-written scanner over an in-memory source. Produces the same tokens,
+// lines and columns as the Flex lexer in lexer.l, which stays the reference
+// implementation. Whitespace, comments, identifiers and numbers are scanned
+// 16 (SSE2) or 32 (AVX2) bytes at a time where the target supports it.
+class Simd_lexer {
+  private:
+    const char *pos_;
+    const char *end_;
+    const char *token_;
+    int yyleng_ = 0;
+    std::ostream *errors_ = &std::cerr;
+
+  public:
+    int yylineno = 1;
+    int yycolumn = 1;
+
+    explicit Simd_lexer(std::string_view text)
+        : pos_(text.data()), end_(text.data() + text.size()),
+          token_(text.data()) {}
+
+    void set_error_stream(std::ostream &errors) noexcept { errors_ = &errors; }
+
+    int get_line() const noexcept { return yylineno; }
+    int get_column() const noexcept { return yycolumn; }
+    int get_yyleng() const noexcept { return yyleng_; }
+
+    std::string_view get_text() const noexcept {
+        return {token_, static_cast<std::size_t>(yyleng_)};
+    }
+
+    // Name of the instruction set the scanning loops were compiled for.
+    static const char *simd_level() noexcept;
+
+    int yylex();
+
+  private:
+    int token(std::size_t length, int kind) noexcept;
+    void skip_whitespace() noexcept;
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_SIMD_LEXER_HPP
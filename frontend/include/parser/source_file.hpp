@@ -0,0 +1,52 @@
+#ifndef FRONTEND_INCLUDE_SOURCE_FILE_HPP
+#define FRONTEND_INCLUDE_SOURCE_FILE_HPP
+
+#include <cstddef>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace language {
+
+// Program text mapped into memory once and shared by the lexer and the
+// diagnostics. Line offsets are only computed when a line is requested.
+class Source_file final {
+  private:
+    std::string name_;
+    void *map_ = nullptr;
+    std::size_t map_size_ = 0;
+    std::string contents_; // used when the file cannot be mapped
+    std::string_view text_;
+
+    mutable std::vector<std::size_t> line_starts_{0};
+    mutable std::size_t indexed_ = 0; // text_ before this offset is indexed
+
+  public:
+    explicit Source_file(std::string name);
+    ~Source_file();
+
+    Source_file(const Source_file &) = delete;
+    Source_file &operator=(const Source_file &) = delete;
+
+    const std::string &name() const noexcept { return name_; }
+    std::string_view text() const noexcept { return text_; }
+
+    // Line numbers start at 1, the result excludes the line terminator.
+    // Returns an empty view for lines past the end of the file.
+    std::string_view line(int number) const;
+};
+
+// Read-only std::streambuf over a memory range, lets the Flex lexer read the
+// mapped source without copying it into a stream first.
+class Source_streambuf final : public std::streambuf {
+  public:
+    explicit Source_streambuf(std::string_view text) {
+        char *begin = const_cast<char *>(text.data());
+        setg(begin, begin, begin + text.size());
+    }
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_SOURCE_FILE_HPP
@@ -0,0 +1,42 @@
+#ifndef FRONTEND_INCLUDE_TRANSLATION_UNIT_HPP
+#define FRONTEND_INCLUDE_TRANSLATION_UNIT_HPP
+
+#include "lexer.hpp"
+#include "my_parser.hpp"
+#include "source_file.hpp"
+#include <istream>
+#include <ostream>
+#include <string>
+
+namespace language {
+
+// A program file together with the lexer and the parser reading it. Units
+// share no state, so different files can be compiled on different threads.
+class Translation_unit final {
+  private:
+    Source_file source_;
+#ifndef SIMD_LEXER
+    Source_streambuf source_buffer_;
+    std::istream program_stream_;
+#endif
+    Lexer scanner_;
+    My_parser parser_;
+
+  public:
+    // Messages of the lexer about unknown characters go to `lexer_errors`.
+    Translation_unit(std::string program_file, std::ostream &lexer_errors,
+                     bool use_huge_pages = false);
+
+    Translation_unit(const Translation_unit &) = delete;
+    Translation_unit &operator=(const Translation_unit &) = delete;
+
+    int parse() { return parser_.parse(); }
+
+    const Source_file &source() const noexcept { return source_; }
+    Lexer &scanner() noexcept { return scanner_; }
+    My_parser &parser() noexcept { return parser_; }
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_TRANSLATION_UNIT_HPP
@@ -0,0 +1,91 @@
+#ifndef FRONTEND_INCLUDE_PROFILER_HPP
+#define FRONTEND_INCLUDE_PROFILER_HPP
+
+#include "node.hpp"
+#include "simulator.hpp"
+#include "source_file.hpp"
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <unordered_map>
+
+namespace language {
+
+// A Simulator that counts how often every statement runs and samples where
+// the time goes. Only `--profile` runs pay for the bookkeeping; the plain
+// Simulator has none of it. Blocks are not measured, their statements are.
+//
+// Reading a clock around every statement would cost more than most
+// statements do, so a timer interrupts the program every `sample_period`
+// instead and charges the sample to the statements running at that moment:
+// the innermost one gets it as self time, all of them as total time. The
+// running time is split between statements in proportion to their samples.
+class Profiler final : public Simulator {
+  public:
+    using clock = std::chrono::steady_clock;
+
+    static constexpr std::chrono::microseconds sample_period{250};
+    // Hot spots shown by report().
+    static constexpr std::size_t hot_spot_limit = 20;
+
+    struct Entry final {
+        const char *kind = nullptr;
+        std::uint64_t count = 0;
+        std::uint64_t self_samples = 0;
+        std::uint64_t total_samples = 0;
+        // Keeps recursion from charging one sample twice to the total.
+        std::uint64_t last_sample = 0;
+    };
+
+    using Entries = std::unordered_map<const Statement *, Entry>;
+    // How often the condition of every `if` and `while` was evaluated.
+    using Evaluations = std::unordered_map<const Expression *, std::uint64_t>;
+
+  private:
+    // The statements being run, innermost first, linked through the native
+    // stack.
+    struct Active final {
+        Entry *entry;
+        Active *outer;
+    };
+
+    Entries entries_;
+    Evaluations conditions_;
+    Active *volatile innermost_ = nullptr;
+    volatile std::uint64_t samples_ = 0;
+    clock::duration elapsed_{};
+
+  public:
+    using Simulator::Simulator;
+    using Simulator::visit;
+
+    void visit(Program &node) override;
+    void visit(Empty_stmt &node) override;
+    void visit(Assignment_stmt &node) override;
+    void visit(If_stmt &node) override;
+    void visit(While_stmt &node) override;
+    void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
+
+    const Entries &get_entries() const noexcept { return entries_; }
+    const Evaluations &get_conditions() const noexcept { return conditions_; }
+    std::uint64_t get_samples() const noexcept { return samples_; }
+    clock::duration get_elapsed() const noexcept { return elapsed_; }
+
+    // Prints the hottest statements by self time, then the source with the
+    // executions and the self time of the statements on each line.
+    void report(std::ostream &os, const Source_file &source) const;
+
+  private:
+    friend class Sampling_timer;
+
+    template <typename Stmt> void measure(Stmt &node, const char *kind);
+    template <typename Stmt, typename Run>
+    void measure(Stmt &node, const char *kind, Run &&run);
+    // Called from the timer's signal handler.
+    void sample() noexcept;
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_PROFILER_HPP
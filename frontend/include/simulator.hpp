@@ -1,19 +1,67 @@
 #ifndef FRONTEND_INCLUDE_SIMULATOR_HPP
 #define FRONTEND_INCLUDE_SIMULATOR_HPP
 
+#include "input_reader.hpp"
+#include "memo_table.hpp"
 #include "node.hpp"
-#include <string>
-#include <unordered_map>
+#include "output_sink.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
 
 namespace language {
 
-class Simulator final : public ASTVisitor {
+class Simulator : public ASTVisitor {
+  public:
+    static constexpr std::size_t default_call_depth = 10000;
+    // The native stack runs out long before, but the frame stack is
+    // allocated for the whole limit.
+    static constexpr std::size_t max_call_depth = 1000000;
 
-    using nametable_t = std::unordered_map<std::string, number_t>;
-    nametable_t nametable_;
+  private:
+    using slots_t = std::vector<number_t>;
+    slots_t slots_;
+    Output_sink &out_;
+    Input_reader &in_;
+
+    // Frames of the active calls, one after another. The stack is sized for
+    // the depth limit, the largest frame and the longest argument list up
+    // front, so calls never allocate.
+    FuncList functions_;
+    std::unique_ptr<number_t[]> stack_;
+    number_t *frame_ = nullptr;
+    number_t *stack_top_ = nullptr;
+    std::size_t depth_ = 0;
+    std::size_t max_depth_;
+    // Calls fail cleanly before the native stack runs out.
+    const char *native_stack_limit_ = nullptr;
+
+    // Set by a return statement until the call it leaves is reached.
+    bool returning_ = false;
+    number_t return_value_ = 0;
+    // Set with returning_ by a tail call, which the call being left runs in
+    // its own frame.
+    Func *tail_callee_ = nullptr;
+
+    // Calls to pure functions are not memoized without a table.
+    Memo_table *memo_;
 
   public:
-    nametable_t &get_nametable() noexcept { return nametable_; }
+    Simulator(Output_sink &out, Input_reader &in,
+              std::size_t max_call_depth = default_call_depth,
+              Memo_table *memo = nullptr)
+        : out_(out), in_(in), max_depth_(max_call_depth), memo_(memo) {}
+
+    slots_t &get_slots() noexcept { return slots_; }
+    Input_reader &get_input() noexcept { return in_; }
+
+    number_t &slot(const Variable &variable) noexcept {
+        return variable.is_local() ? frame_[variable.get_slot()]
+                                   : slots_[variable.get_slot()];
+    }
+
+    number_t define(Func &func);
+    number_t call(Call &call);
 
     void visit(Program &node) override;
     void visit(Block_stmt &node) override;
@@ -29,6 +77,7 @@ class Simulator final : public ASTVisitor {
     void visit(While_stmt &node) override;
 
     void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
 
     void visit(Assignment_expr &node) override;
     void visit(Binary_operator &node) override;
@@ -39,8 +88,15 @@ class Simulator final : public ASTVisitor {
     void visit(Func &node) override;
     void visit(Call &node) override;
 
-  private:
+  protected:
     number_t evaluate_expression(Expression &expression);
+    // Whether a return statement is leaving the current call.
+    bool returning() const noexcept { return returning_; }
+
+  private:
+    Func &resolve(Call &call);
+    void tail_call(Call &call);
+    void prepare_call_stack(const Program &program);
 };
 
 } // namespace language
@@ -0,0 +1,56 @@
+#ifndef FRONTEND_INCLUDE_VM_BYTECODE_HPP
+#define FRONTEND_INCLUDE_VM_BYTECODE_HPP
+
+#include "config.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace language {
+
+enum class Opcode : std::uint8_t {
+    Push_const,
+    Load,
+    Store,
+    Store_keep,
+    Pop,
+    Input,
+    Print,
+    Eq,
+    Neq,
+    Less,
+    LessEq,
+    Greater,
+    GreaterEq,
+    Add,
+    Sub,
+    Mul,
+    Div,
+    RemDiv,
+    And,
+    Xor,
+    Or,
+    LogOr,
+    LogAnd,
+    Neg,
+    Not,
+    Jump,
+    Jump_if_false,
+    Jump_if_true,
+    Halt,
+};
+
+struct Instruction final {
+    Opcode op;
+    number_t arg = 0;
+};
+
+struct Bytecode final {
+    std::vector<Instruction> code;
+    std::size_t n_variables = 0;
+    std::size_t max_stack_depth = 0;
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_VM_BYTECODE_HPP
@@ -0,0 +1,43 @@
+#ifndef FRONTEND_INCLUDE_VM_BYTECODE_COMPILER_HPP
+#define FRONTEND_INCLUDE_VM_BYTECODE_COMPILER_HPP
+
+#include "bytecode.hpp"
+#include "node.hpp"
+
+namespace language {
+
+class Bytecode_compiler final : public ASTVisitor {
+  private:
+    Bytecode bytecode_;
+    std::size_t stack_depth_ = 0;
+
+  public:
+    Bytecode compile(Program &program);
+
+    void visit(Program &node) override;
+    void visit(Block_stmt &node) override;
+    void visit(Empty_stmt &node) override;
+    void visit(Assignment_stmt &node) override;
+    void visit(Input &node) override;
+    void visit(If_stmt &node) override;
+    void visit(While_stmt &node) override;
+    void visit(Print_stmt &node) override;
+    void visit(Return_stmt &node) override;
+    void visit(Assignment_expr &node) override;
+    void visit(Binary_operator &node) override;
+    void visit(Unary_operator &node) override;
+    void visit(Number &node) override;
+    void visit(Variable &node) override;
+
+    void visit(Func &node) override;
+    void visit(Call &node) override;
+
+  private:
+    std::size_t emit(Opcode op, number_t arg = 0);
+    std::size_t current_address() const noexcept;
+    void patch_jump(std::size_t jump, std::size_t target) noexcept;
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_VM_BYTECODE_COMPILER_HPP
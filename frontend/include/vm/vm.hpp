@@ -0,0 +1,27 @@
+#ifndef FRONTEND_INCLUDE_VM_VM_HPP
+#define FRONTEND_INCLUDE_VM_VM_HPP
+
+#include "bytecode.hpp"
+#include "input_reader.hpp"
+#include "output_sink.hpp"
+#include <vector>
+
+namespace language {
+
+class Vm final {
+  private:
+    const Bytecode &bytecode_;
+    std::vector<number_t> variables_;
+    std::vector<number_t> stack_;
+    Output_sink &out_;
+    Input_reader &in_;
+
+  public:
+    Vm(const Bytecode &bytecode, Output_sink &out, Input_reader &in);
+
+    void run();
+};
+
+} // namespace language
+
+#endif // FRONTEND_INCLUDE_VM_VM_HPP
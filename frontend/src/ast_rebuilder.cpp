@@ -0,0 +1,84 @@
+#include "ast_rebuilder.hpp"
+#include <stdexcept>
+
+namespace language {
+
+Program &Ast_rebuilder::rebuild() {
+    slot_symbols_.clear();
+    slot_symbols_.reserve(ast_.slot_count());
+    for (slot_t slot = 0; slot < ast_.slot_count(); ++slot)
+        slot_symbols_.push_back(symbols_.intern(ast_.slot_name(slot)));
+
+    return *pool_.make<Program>(statements(ast_.root()), ast_.slot_count(),
+                                symbols_);
+}
+
+Statement_ptr Ast_rebuilder::statement(node_id id) {
+    switch (ast_.kind(id)) {
+    case Node_kind::Block_stmt:
+        return pool_.make<Block_stmt>(statements(id));
+    case Node_kind::Empty_stmt:
+        return pool_.make<Empty_stmt>();
+    case Node_kind::Assignment_stmt:
+        return pool_.make<Assignment_stmt>(variable(id),
+                                           expression(ast_.value(id)));
+    case Node_kind::If_stmt: {
+        auto *condition = expression(ast_.condition(id));
+        auto *then_branch = statement(ast_.then_branch(id));
+        const auto else_id = ast_.else_branch(id);
+        return pool_.make<If_stmt>(condition, then_branch,
+                                   else_id == Flat_ast::no_node
+                                       ? nullptr
+                                       : statement(else_id));
+    }
+    case Node_kind::While_stmt: {
+        auto *condition = expression(ast_.condition(id));
+        return pool_.make<While_stmt>(condition, statement(ast_.body(id)));
+    }
+    case Node_kind::Print_stmt:
+        return pool_.make<Print_stmt>(expression(ast_.value(id)));
+    default:
+        throw std::runtime_error("flat AST node is not a statement");
+    }
+}
+
+Expression_ptr Ast_rebuilder::expression(node_id id) {
+    switch (ast_.kind(id)) {
+    case Node_kind::Assignment_expr:
+        return pool_.make<Assignment_expr>(variable(id),
+                                           expression(ast_.value(id)));
+    case Node_kind::Input:
+        return pool_.make<Input>();
+    case Node_kind::Binary_operator: {
+        auto *left = expression(ast_.left(id));
+        return pool_.make<Binary_operator>(ast_.binary_operator(id), left,
+                                           expression(ast_.right(id)));
+    }
+    case Node_kind::Unary_operator:
+        return pool_.make<Unary_operator>(ast_.unary_operator(id),
+                                          expression(ast_.operand(id)));
+    case Node_kind::Number:
+        return pool_.make<Number>(ast_.number(id));
+    case Node_kind::Variable:
+        return variable(id);
+    default:
+        throw std::runtime_error("flat AST node is not an expression");
+    }
+}
+
+StmtList Ast_rebuilder::statements(node_id id) {
+    StmtList stmts;
+    const auto children = ast_.stmts(id);
+    stmts.reserve(children.size());
+    for (const auto child : children)
+        stmts.push_back(statement(child));
+    return stmts;
+}
+
+// Assignments and variables keep their slot in `first`.
+Variable_ptr Ast_rebuilder::variable(node_id id) {
+    const auto slot = ast_.slot(id);
+    return pool_.make<Variable>(slot_symbols_[slot], slot);
+}
+
+} // namespace language
@@ -0,0 +1,81 @@
+#include "ast_walker.hpp"
+#include "node.hpp"
+
+namespace language {
+
+void AST_walker::visit(Program &node) {
+    enter(node);
+    for (const auto &stmt : node.get_stmts())
+        stmt->accept(*this);
+}
+
+void AST_walker::visit(Block_stmt &node) {
+    enter(node);
+    for (const auto &stmt : node.get_stmts())
+        stmt->accept(*this);
+}
+
+void AST_walker::visit(Empty_stmt &node) { enter(node); }
+
+void AST_walker::visit(Assignment_stmt &node) {
+    enter(node);
+    node.get_value().accept(*this);
+}
+
+void AST_walker::visit(Assignment_expr &node) {
+    enter(node);
+    node.get_value().accept(*this);
+}
+
+void AST_walker::visit(If_stmt &node) {
+    enter(node);
+    node.get_condition().accept(*this);
+    node.then_branch().accept(*this);
+    if (node.contains_else_branch())
+        node.else_branch().accept(*this);
+}
+
+void AST_walker::visit(While_stmt &node) {
+    enter(node);
+    node.get_condition().accept(*this);
+    node.get_body().accept(*this);
+}
+
+void AST_walker::visit(Print_stmt &node) {
+    enter(node);
+    node.get_value().accept(*this);
+}
+
+void AST_walker::visit(Return_stmt &node) {
+    enter(node);
+    node.get_value().accept(*this);
+}
+
+void AST_walker::visit(Binary_operator &node) {
+    enter(node);
+    node.get_left().accept(*this);
+    node.get_right().accept(*this);
+}
+
+void AST_walker::visit(Unary_operator &node) {
+    enter(node);
+    node.get_operand().accept(*this);
+}
+
+void AST_walker::visit(Input &node) { enter(node); }
+void AST_walker::visit(Number &node) { enter(node); }
+void AST_walker::visit(Variable &node) { enter(node); }
+
+void AST_walker::visit(Func &node) {
+    enter(node);
+    node.get_body().accept(*this);
+}
+
+void AST_walker::visit(Call &node) {
+    enter(node);
+    node.get_target().accept(*this);
+    for (auto *arg : node.get_args())
+        arg->accept(*this);
+}
+
+} // namespace language
@@ -0,0 +1,198 @@
+#include "bytecode_compiler.hpp"
+#include "node.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace language {
+
+namespace {
+
+int stack_effect(Opcode op) noexcept {
+    switch (op) {
+    case Opcode::Push_const:
+    case Opcode::Load:
+    case Opcode::Input:
+        return 1;
+    case Opcode::Store_keep:
+    case Opcode::Neg:
+    case Opcode::Not:
+    case Opcode::Jump:
+    case Opcode::Halt:
+        return 0;
+    default:
+        return -1;
+    }
+}
+
+Opcode binary_opcode(Binary_operators op) {
+    switch (op) {
+    case Binary_operators::Eq:
+        return Opcode::Eq;
+    case Binary_operators::Neq:
+        return Opcode::Neq;
+    case Binary_operators::Less:
+        return Opcode::Less;
+    case Binary_operators::LessEq:
+        return Opcode::LessEq;
+    case Binary_operators::Greater:
+        return Opcode::Greater;
+    case Binary_operators::GreaterEq:
+        return Opcode::GreaterEq;
+    case Binary_operators::Add:
+        return Opcode::Add;
+    case Binary_operators::Sub:
+        return Opcode::Sub;
+    case Binary_operators::Mul:
+        return Opcode::Mul;
+    case Binary_operators::Div:
+        return Opcode::Div;
+    case Binary_operators::RemDiv:
+        return Opcode::RemDiv;
+    case Binary_operators::And:
+        return Opcode::And;
+    case Binary_operators::Xor:
+        return Opcode::Xor;
+    case Binary_operators::Or:
+        return Opcode::Or;
+    case Binary_operators::LogOr:
+        return Opcode::LogOr;
+    case Binary_operators::LogAnd:
+        return Opcode::LogAnd;
+    }
+    throw std::runtime_error("Unknown binary operator");
+}
+
+} // namespace
+
+Bytecode Bytecode_compiler::compile(Program &program) {
+    bytecode_ = Bytecode{};
+    bytecode_.n_variables = program.get_slot_count();
+    stack_depth_ = 0;
+
+    program.accept(*this);
+    emit(Opcode::Halt);
+
+    return std::move(bytecode_);
+}
+
+void Bytecode_compiler::visit(Program &node) {
+    for (const auto &stmt : node.get_stmts())
+        stmt->accept(*this);
+}
+
+void Bytecode_compiler::visit(Block_stmt &node) {
+    for (const auto &stmt : node.get_stmts())
+        stmt->accept(*this);
+}
+
+void Bytecode_compiler::visit(Empty_stmt &node) {}
+
+void Bytecode_compiler::visit(Assignment_stmt &node) {
+    node.get_value().accept(*this);
+    emit(Opcode::Store, node.get_variable()->get_slot());
+}
+
+void Bytecode_compiler::visit(Assignment_expr &node) {
+    node.get_value().accept(*this);
+    emit(Opcode::Store_keep, node.get_variable()->get_slot());
+}
+
+void Bytecode_compiler::visit(If_stmt &node) {
+    node.get_condition().accept(*this);
+    const auto jump_to_else = emit(Opcode::Jump_if_false);
+
+    node.then_branch().accept(*this);
+
+    if (!node.contains_else_branch()) {
+        patch_jump(jump_to_else, current_address());
+        return;
+    }
+
+    const auto jump_to_end = emit(Opcode::Jump);
+    patch_jump(jump_to_else, current_address());
+    node.else_branch().accept(*this);
+    patch_jump(jump_to_end, current_address());
+}
+
+void Bytecode_compiler::visit(While_stmt &node) {
+    // The condition is placed after the body, so each iteration costs a
+    // single conditional jump.
+    const auto jump_to_condition = emit(Opcode::Jump);
+
+    const auto body = current_address();
+    node.get_body().accept(*this);
+
+    patch_jump(jump_to_condition, current_address());
+    node.get_condition().accept(*this);
+    emit(Opcode::Jump_if_true, static_cast<number_t>(body));
+}
+
+void Bytecode_compiler::visit(Print_stmt &node) {
+    node.get_value().accept(*this);
+    emit(Opcode::Print);
+}
+
+void Bytecode_compiler::visit(Return_stmt &node) {
+    throw std::runtime_error("functions are not supported by the bytecode VM");
+}
+
+void Bytecode_compiler::visit(Input &node) { emit(Opcode::Input); }
+
+void Bytecode_compiler::visit(Binary_operator &node) {
+    node.get_left().accept(*this);
+    node.get_right().accept(*this);
+    emit(binary_opcode(node.get_operator()));
+}
+
+void Bytecode_compiler::visit(Unary_operator &node) {
+    node.get_operand().accept(*this);
+
+    switch (node.get_operator()) {
+    case Unary_operators::Neg:
+        emit(Opcode::Neg);
+        break;
+    case Unary_operators::Plus:
+        break;
+    case Unary_operators::Not:
+        emit(Opcode::Not);
+        break;
+    default:
+        throw std::runtime_error("Unknown unary operator");
+    }
+}
+
+void Bytecode_compiler::visit(Number &node) {
+    emit(Opcode::Push_const, node.get_value());
+}
+
+void Bytecode_compiler::visit(Variable &node) {
+    emit(Opcode::Load, node.get_slot());
+}
+
+void Bytecode_compiler::visit(Func &node) {
+    throw std::runtime_error("functions are not supported by the bytecode VM");
+}
+
+void Bytecode_compiler::visit(Call &node) {
+    throw std::runtime_error("calls are not supported by the bytecode VM");
+}
+
+std::size_t Bytecode_compiler::emit(Opcode op, number_t arg) {
+    stack_depth_ += stack_effect(op);
+    bytecode_.max_stack_depth =
+        std::max(bytecode_.max_stack_depth, stack_depth_);
+
+    bytecode_.code.push_back(Instruction{op, arg});
+    return bytecode_.code.size() - 1;
+}
+
+std::size_t Bytecode_compiler::current_address() const noexcept {
+    return bytecode_.code.size();
+}
+
+void Bytecode_compiler::patch_jump(std::size_t jump,
+                                   std::size_t target) noexcept {
+    bytecode_.code[jump].arg = static_cast<number_t>(target);
+}
+
+} // namespace language
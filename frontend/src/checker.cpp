@@ -0,0 +1,62 @@
+#include "checker.hpp"
+#include "translation_unit.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <sstream>
+#include <string_view>
+#include <thread>
+
+namespace language {
+
+Check_result check_program(const std::string &program_file,
+                           bool use_huge_pages) {
+    std::ostringstream output;
+    try {
+        Translation_unit unit{program_file, output, use_huge_pages};
+        const int result = unit.parse();
+
+        const auto &errors = unit.parser().error_collector;
+        if (errors.has_errors()) {
+            output << "FAILED: ";
+            errors.print_errors(output);
+            return {false, output.str()};
+        }
+        if (result != 0) {
+            output << program_file << ": error: unknown error\n";
+            return {false, output.str()};
+        }
+        return {true, output.str()};
+    } catch (const std::exception &e) {
+        const std::string_view message = e.what();
+        output << program_file << ": error: " << message;
+        if (!message.ends_with('\n'))
+            output << '\n';
+        return {false, output.str()};
+    }
+}
+
+std::vector<Check_result>
+check_programs(const std::vector<std::string> &program_files,
+               std::size_t jobs, bool use_huge_pages) {
+    std::vector<Check_result> results(program_files.size());
+    std::atomic<std::size_t> next{0};
+
+    // Workers take the next unchecked file until none are left; each result
+    // lands in the slot of its file.
+    const auto worker = [&] {
+        for (auto i = next++; i < program_files.size(); i = next++)
+            results[i] = check_program(program_files[i], use_huge_pages);
+    };
+
+    const auto thread_count = std::min(jobs, program_files.size());
+    {
+        std::vector<std::jthread> threads;
+        threads.reserve(thread_count);
+        for (std::size_t i = 0; i < thread_count; ++i)
+            threads.emplace_back(worker);
+    }
+    return results;
+}
+
+} // namespace language
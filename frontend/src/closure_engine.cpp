@@ -0,0 +1,274 @@
+#include "closure_engine.hpp"
+#include "node.hpp"
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+namespace language {
+
+namespace {
+
+using Shape = Operand::Shape;
+
+Operand make_closure_operand(Expr_closure closure) {
+    Operand operand;
+    operand.shape = Shape::Closure;
+    operand.closure = std::move(closure);
+    return operand;
+}
+
+template <typename Op>
+Expr_closure make_binary(const Operand &lhs, const Operand &rhs) {
+    const auto l = lhs.shape;
+    const auto r = rhs.shape;
+
+    if (l == Shape::Slot && r == Shape::Constant)
+        return [a = lhs.slot, c = rhs.value] { return Op{}(*a, c); };
+    if (l == Shape::Slot && r == Shape::Slot)
+        return [a = lhs.slot, b = rhs.slot] { return Op{}(*a, *b); };
+    if (l == Shape::Constant && r == Shape::Slot)
+        return [c = lhs.value, b = rhs.slot] { return Op{}(c, *b); };
+    if (l == Shape::Closure && r == Shape::Constant)
+        return [f = lhs.closure, c = rhs.value] { return Op{}(f(), c); };
+    // Operands are evaluated left to right, as by the Simulator, even when
+    // the closure assigns the slot.
+    if (l == Shape::Closure && r == Shape::Slot)
+        return [f = lhs.closure, b = rhs.slot] {
+            const number_t lhs_value = f();
+            return Op{}(lhs_value, *b);
+        };
+    if (l == Shape::Slot && r == Shape::Closure)
+        return [a = lhs.slot, g = rhs.closure] {
+            const number_t lhs_value = *a;
+            return Op{}(lhs_value, g());
+        };
+
+    return [f = lhs.to_closure(), g = rhs.to_closure()] {
+        const number_t lhs_value = f();
+        return Op{}(lhs_value, g());
+    };
+}
+
+template <typename Op> Expr_closure make_unary(const Operand &operand) {
+    if (operand.shape == Shape::Slot)
+        return [a = operand.slot] { return Op{}(*a); };
+
+    return [f = operand.to_closure()] { return Op{}(f()); };
+}
+
+Expr_closure make_binary(Binary_operators op, const Operand &lhs,
+                         const Operand &rhs) {
+    switch (op) {
+    case Binary_operators::Eq:
+        return make_binary<std::equal_to<number_t>>(lhs, rhs);
+    case Binary_operators::Neq:
+        return make_binary<std::not_equal_to<number_t>>(lhs, rhs);
+    case Binary_operators::Less:
+        return make_binary<std::less<number_t>>(lhs, rhs);
+    case Binary_operators::LessEq:
+        return make_binary<std::less_equal<number_t>>(lhs, rhs);
+    case Binary_operators::Greater:
+        return make_binary<std::greater<number_t>>(lhs, rhs);
+    case Binary_operators::GreaterEq:
+        return make_binary<std::greater_equal<number_t>>(lhs, rhs);
+    case Binary_operators::Add:
+        return make_binary<std::plus<number_t>>(lhs, rhs);
+    case Binary_operators::Sub:
+        return make_binary<std::minus<number_t>>(lhs, rhs);
+    case Binary_operators::Mul:
+        return make_binary<std::multiplies<number_t>>(lhs, rhs);
+    case Binary_operators::Div:
+        return make_binary<std::divides<number_t>>(lhs, rhs);
+    case Binary_operators::RemDiv:
+        return make_binary<std::modulus<number_t>>(lhs, rhs);
+    case Binary_operators::And:
+        return make_binary<std::bit_and<number_t>>(lhs, rhs);
+    case Binary_operators::Xor:
+        return make_binary<std::bit_xor<number_t>>(lhs, rhs);
+    case Binary_operators::Or:
+        return make_binary<std::bit_or<number_t>>(lhs, rhs);
+    case Binary_operators::LogOr:
+        return make_binary<std::logical_or<number_t>>(lhs, rhs);
+    case Binary_operators::LogAnd:
+        return make_binary<std::logical_and<number_t>>(lhs, rhs);
+    }
+    throw std::runtime_error("Unknown binary operator");
+}
+
+} // namespace
+
+Expr_closure Operand::to_closure() const {
+    switch (shape) {
+    case Shape::Constant:
+        return [c = value] { return c; };
+    case Shape::Slot:
+        return [a = slot] { return *a; };
+    case Shape::Closure:
+        return closure;
+    }
+    throw std::runtime_error("Unknown operand shape");
+}
+
+Stmt_closure Closure_compiler::compile(Program &program) {
+    program.accept(*this);
+    return std::move(stmt_);
+}
+
+void Closure_compiler::visit(Program &node) {
+    stmt_ = compile_stmts(node.get_stmts());
+}
+
+void Closure_compiler::visit(Block_stmt &node) {
+    stmt_ = compile_stmts(node.get_stmts());
+}
+
+void Closure_compiler::visit(Empty_stmt &node) {
+    stmt_ = [] {};
+}
+
+void Closure_compiler::visit(Assignment_stmt &node) {
+    number_t *target = slots_ + node.get_variable()->get_slot();
+    const auto value = compile_expression(node.get_value());
+
+    switch (value.shape) {
+    case Shape::Constant:
+        stmt_ = [target, c = value.value] { *target = c; };
+        break;
+    case Shape::Slot:
+        stmt_ = [target, a = value.slot] { *target = *a; };
+        break;
+    case Shape::Closure:
+        stmt_ = [target, f = value.closure] { *target = f(); };
+        break;
+    }
+}
+
+void Closure_compiler::visit(If_stmt &node) {
+    auto condition = compile_expression(node.get_condition()).to_closure();
+    auto then_branch = compile_statement(node.then_branch());
+
+    if (!node.contains_else_branch()) {
+        stmt_ = [c = std::move(condition), t = std::move(then_branch)] {
+            if (c())
+                t();
+        };
+        return;
+    }
+
+    auto else_branch = compile_statement(node.else_branch());
+    stmt_ = [c = std::move(condition), t = std::move(then_branch),
+             e = std::move(else_branch)] {
+        if (c())
+            t();
+        else
+            e();
+    };
+}
+
+void Closure_compiler::visit(While_stmt &node) {
+    auto condition = compile_expression(node.get_condition()).to_closure();
+    auto body = compile_statement(node.get_body());
+
+    stmt_ = [c = std::move(condition), b = std::move(body)] {
+        while (c())
+            b();
+    };
+}
+
+void Closure_compiler::visit(Print_stmt &node) {
+    auto value = compile_expression(node.get_value()).to_closure();
+
+    stmt_ = [f = std::move(value), &out = out_] { out.print(f()); };
+}
+
+void Closure_compiler::visit(Return_stmt &node) {
+    throw std::runtime_error(
+        "functions are not supported by the closure engine");
+}
+
+void Closure_compiler::visit(Input &node) {
+    operand_ =
+        make_closure_operand([&in = in_] { return in.read_number(); });
+}
+
+void Closure_compiler::visit(Assignment_expr &node) {
+    number_t *target = slots_ + node.get_variable()->get_slot();
+    auto value = compile_expression(node.get_value()).to_closure();
+
+    operand_ = make_closure_operand(
+        [target, f = std::move(value)] { return *target = f(); });
+}
+
+void Closure_compiler::visit(Binary_operator &node) {
+    const auto lhs = compile_expression(node.get_left());
+    const auto rhs = compile_expression(node.get_right());
+
+    operand_ = make_closure_operand(make_binary(node.get_operator(), lhs, rhs));
+}
+
+void Closure_compiler::visit(Unary_operator &node) {
+    auto operand = compile_expression(node.get_operand());
+
+    switch (node.get_operator()) {
+    case Unary_operators::Neg:
+        operand_ = make_closure_operand(
+            make_unary<std::negate<number_t>>(operand));
+        break;
+    case Unary_operators::Plus:
+        operand_ = std::move(operand);
+        break;
+    case Unary_operators::Not:
+        operand_ = make_closure_operand(
+            make_unary<std::logical_not<number_t>>(operand));
+        break;
+    default:
+        throw std::runtime_error("Unknown unary operator");
+    }
+}
+
+void Closure_compiler::visit(Number &node) {
+    operand_ = Operand{};
+    operand_.value = node.get_value();
+}
+
+void Closure_compiler::visit(Variable &node) {
+    operand_ = Operand{};
+    operand_.shape = Shape::Slot;
+    operand_.slot = slots_ + node.get_slot();
+}
+
+void Closure_compiler::visit(Func &node) {
+    throw std::runtime_error(
+        "functions are not supported by the closure engine");
+}
+
+void Closure_compiler::visit(Call &node) {
+    throw std::runtime_error("calls are not supported by the closure engine");
+}
+
+Operand Closure_compiler::compile_expression(Expression &expression) {
+    expression.accept(*this);
+    return std::move(operand_);
+}
+
+Stmt_closure Closure_compiler::compile_statement(Statement &statement) {
+    statement.accept(*this);
+    return std::move(stmt_);
+}
+
+Stmt_closure Closure_compiler::compile_stmts(const StmtList &stmts) {
+    std::vector<Stmt_closure> closures;
+    closures.reserve(stmts.size());
+    for (auto *stmt : stmts)
+        closures.push_back(compile_statement(*stmt));
+
+    if (closures.size() == 1)
+        return std::move(closures.front());
+
+    return [closures = std::move(closures)] {
+        for (const auto &closure : closures)
+            closure();
+    };
+}
+
+} // namespace language
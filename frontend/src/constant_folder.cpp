@@ -0,0 +1,216 @@
+#include "constant_folder.hpp"
+#include "node.hpp"
+#include "slot_usage.hpp"
+#include <cstdint>
+#include <limits>
+
+namespace language {
+
+namespace {
+
+// Arithmetic is done on unsigned values to get the wrap-around the
+// interpreters produce at runtime without undefined behaviour here.
+using unsigned_t = std::make_unsigned_t<number_t>;
+
+number_t wrap(unsigned_t value) noexcept { return static_cast<number_t>(value); }
+
+std::optional<number_t> constant_of(const Expression &expression) {
+    if (const auto *number = dynamic_cast<const Number *>(&expression))
+        return number->get_value();
+    return std::nullopt;
+}
+
+} // namespace
+
+std::optional<number_t> fold_binary(Binary_operators op, number_t lhs,
+                                    number_t rhs) noexcept {
+    const auto ulhs = static_cast<unsigned_t>(lhs);
+    const auto urhs = static_cast<unsigned_t>(rhs);
+
+    switch (op) {
+    case Binary_operators::Eq:
+        return lhs == rhs;
+    case Binary_operators::Neq:
+        return lhs != rhs;
+    case Binary_operators::Less:
+        return lhs < rhs;
+    case Binary_operators::LessEq:
+        return lhs <= rhs;
+    case Binary_operators::Greater:
+        return lhs > rhs;
+    case Binary_operators::GreaterEq:
+        return lhs >= rhs;
+    case Binary_operators::Add:
+        return wrap(ulhs + urhs);
+    case Binary_operators::Sub:
+        return wrap(ulhs - urhs);
+    case Binary_operators::Mul:
+        return wrap(ulhs * urhs);
+    case Binary_operators::Div:
+    case Binary_operators::RemDiv:
+        if (rhs == 0 ||
+            (lhs == std::numeric_limits<number_t>::min() && rhs == -1))
+            return std::nullopt;
+        return op == Binary_operators::Div ? lhs / rhs : lhs % rhs;
+    case Binary_operators::And:
+        return lhs & rhs;
+    case Binary_operators::Xor:
+        return lhs ^ rhs;
+    case Binary_operators::Or:
+        return lhs | rhs;
+    case Binary_operators::LogOr:
+        return lhs || rhs;
+    case Binary_operators::LogAnd:
+        return lhs && rhs;
+    }
+    return std::nullopt;
+}
+
+number_t fold_unary(Unary_operators op, number_t value) noexcept {
+    switch (op) {
+    case Unary_operators::Neg:
+        return wrap(unsigned_t{0} - static_cast<unsigned_t>(value));
+    case Unary_operators::Plus:
+        return value;
+    case Unary_operators::Not:
+        return !value;
+    }
+    return value;
+}
+
+void Constant_folder::run(Program &program) {
+    slot_count_ = program.get_slot_count();
+    facts_.assign(slot_count_, std::nullopt);
+    folded_ = 0;
+
+    program.accept(*this);
+}
+
+void Constant_folder::visit(Program &node) {
+    for (const auto &stmt : node.get_stmts())
+        stmt->accept(*this);
+}
+
+void Constant_folder::visit(Block_stmt &node) {
+    for (const auto &stmt : node.get_stmts())
+        stmt->accept(*this);
+}
+
+void Constant_folder::visit(Empty_stmt &node) {}
+
+void Constant_folder::visit(Assignment_stmt &node) {
+    node.set_value(fold(node.get_value()));
+    facts_[node.get_variable()->get_slot()] = constant_of(node.get_value());
+}
+
+void Constant_folder::visit(Assignment_expr &node) {
+    node.set_value(fold(node.get_value()));
+    facts_[node.get_variable()->get_slot()] = constant_of(node.get_value());
+    result_ = &node;
+}
+
+void Constant_folder::visit(If_stmt &node) {
+    node.set_condition(fold(node.get_condition()));
+
+    const auto before = facts_;
+    node.then_branch().accept(*this);
+    auto after_then = std::move(facts_);
+
+    facts_ = before;
+    if (node.contains_else_branch())
+        node.else_branch().accept(*this);
+
+    // Only facts that hold on both paths survive the join.
+    for (slot_t slot = 0; slot < slot_count_; ++slot) {
+        if (facts_[slot] != after_then[slot])
+            facts_[slot].reset();
+    }
+}
+
+void Constant_folder::visit(While_stmt &node) {
+    // Everything assigned in the loop changes between iterations.
+    Slot_usage_collector usage{slot_count_};
+    node.accept(usage);
+    if (usage.has_calls())
+        facts_.assign(slot_count_, std::nullopt);
+    else
+        kill(usage.get_written());
+    const auto loop_head = facts_;
+
+    node.set_condition(fold(node.get_condition()));
+    node.get_body().accept(*this);
+
+    facts_ = loop_head;
+}
+
+void Constant_folder::visit(Print_stmt &node) {
+    node.set_value(fold(node.get_value()));
+}
+
+void Constant_folder::visit(Return_stmt &node) {
+    node.set_value(fold(node.get_value()));
+}
+
+void Constant_folder::visit(Input &node) { result_ = &node; }
+
+void Constant_folder::visit(Binary_operator &node) {
+    node.set_left(fold(node.get_left()));
+    node.set_right(fold(node.get_right()));
+    result_ = &node;
+
+    const auto lhs = constant_of(node.get_left());
+    const auto rhs = constant_of(node.get_right());
+    if (!lhs || !rhs)
+        return;
+
+    if (const auto value = fold_binary(node.get_operator(), *lhs, *rhs))
+        result_ = make_number(*value);
+}
+
+void Constant_folder::visit(Unary_operator &node) {
+    node.set_operand(fold(node.get_operand()));
+    result_ = &node;
+
+    if (const auto value = constant_of(node.get_operand()))
+        result_ = make_number(fold_unary(node.get_operator(), *value));
+}
+
+void Constant_folder::visit(Number &node) { result_ = &node; }
+
+void Constant_folder::visit(Variable &node) {
+    result_ = &node;
+
+    if (const auto value = facts_[node.get_slot()])
+        result_ = make_number(*value);
+}
+
+void Constant_folder::visit(Func &node) { result_ = &node; }
+
+void Constant_folder::visit(Call &node) {
+    node.set_target(fold(node.get_target()));
+    for (auto &arg : node.get_args())
+        arg = fold(*arg);
+
+    // The callee may assign any variable.
+    facts_.assign(slot_count_, std::nullopt);
+    result_ = &node;
+}
+
+Expression_ptr Constant_folder::fold(Expression &expression) {
+    expression.accept(*this);
+    return result_;
+}
+
+Expression_ptr Constant_folder::make_number(number_t value) {
+    ++folded_;
+    return pool_.make<Number>(value);
+}
+
+void Constant_folder::kill(const std::vector<bool> &written) {
+    for (slot_t slot = 0; slot < slot_count_; ++slot) {
+        if (written[slot])
+            facts_[slot].reset();
+    }
+}
+
+} // namespace language
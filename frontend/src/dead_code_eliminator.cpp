@@ -0,0 +1,174 @@
+#include "dead_code_eliminator.hpp"
+#include "ast_walker.hpp"
+#include "node.hpp"
+#include "slot_usage.hpp"
+
+namespace language {
+
+namespace {
+
+class Node_counter final : public AST_walker {
+  private:
+    std::size_t count_ = 0;
+
+  protected:
+    void enter(Node &node) override { ++count_; }
+
+  public:
+    std::size_t get_count() const noexcept { return count_; }
+};
+
+class Purity_checker final : public AST_walker {
+  private:
+    bool pure_ = true;
+
+  public:
+    bool is_pure() const noexcept { return pure_; }
+
+    using AST_walker::visit;
+
+    void visit(Input &node) override { pure_ = false; }
+    void visit(Call &node) override { pure_ = false; }
+    void visit(Assignment_expr &node) override { pure_ = false; }
+
+    void visit(Binary_operator &node) override {
+        const auto op = node.get_operator();
+        if (op == Binary_operators::Div || op == Binary_operators::RemDiv) {
+            // x / -1 traps for x == INT_MIN as well.
+            const auto *divisor = dynamic_cast<Number *>(&node.get_right());
+            if (!divisor || divisor->get_value() == 0 ||
+                divisor->get_value() == -1)
+                pure_ = false;
+        }
+        AST_walker::visit(node);
+    }
+
+    // A function literal only evaluates to its id.
+    void visit(Func &node) override {}
+};
+
+Number *as_number(Expression &expression) {
+    return dynamic_cast<Number *>(&expression);
+}
+
+} // namespace
+
+std::size_t count_nodes(Node &node) {
+    Node_counter counter;
+    node.accept(counter);
+    return counter.get_count();
+}
+
+bool is_pure(Expression &expression) {
+    Purity_checker checker;
+    expression.accept(checker);
+    return checker.is_pure();
+}
+
+std::size_t Dead_code_eliminator::run(Program &program) {
+    const auto before = count_nodes(program);
+
+    // Removing a store may leave the variables it read unused, so repeat
+    // until nothing changes.
+    std::size_t previous = 0;
+    std::size_t current = before;
+    do {
+        previous = current;
+        read_ = collect_read_slots(program, program.get_slot_count());
+        program.accept(*this);
+        current = count_nodes(program);
+    } while (current < previous);
+
+    return before - current;
+}
+
+void Dead_code_eliminator::visit(Program &node) { eliminate(node.get_stmts()); }
+
+void Dead_code_eliminator::visit(Block_stmt &node) {
+    eliminate(node.get_stmts());
+    result_ = node.get_stmts().empty() ? nullptr : &node;
+}
+
+void Dead_code_eliminator::visit(Empty_stmt &node) { result_ = nullptr; }
+
+void Dead_code_eliminator::visit(Assignment_stmt &node) {
+    const bool dead = !read_[node.get_variable()->get_slot()] &&
+                      is_pure(node.get_value());
+    result_ = dead ? nullptr : &node;
+}
+
+void Dead_code_eliminator::visit(If_stmt &node) {
+    if (const auto *condition = as_number(node.get_condition())) {
+        if (condition->get_value())
+            result_ = eliminate(node.then_branch());
+        else if (node.contains_else_branch())
+            result_ = eliminate(node.else_branch());
+        else
+            result_ = nullptr;
+        return;
+    }
+
+    if (node.contains_else_branch())
+        node.set_else_branch(eliminate(node.else_branch()));
+    node.set_then_branch(eliminate_or_empty(node.then_branch()));
+
+    const bool empty = dynamic_cast<Empty_stmt *>(&node.then_branch()) &&
+                       !node.contains_else_branch();
+    if (empty && is_pure(node.get_condition())) {
+        result_ = nullptr;
+        return;
+    }
+
+    result_ = &node;
+}
+
+void Dead_code_eliminator::visit(While_stmt &node) {
+    const auto *condition = as_number(node.get_condition());
+    if (condition && !condition->get_value()) {
+        result_ = nullptr;
+        return;
+    }
+
+    node.set_body(eliminate_or_empty(node.get_body()));
+    result_ = &node;
+}
+
+void Dead_code_eliminator::visit(Print_stmt &node) { result_ = &node; }
+void Dead_code_eliminator::visit(Return_stmt &node) { result_ = &node; }
+
+// Expressions are left to the constant folder.
+void Dead_code_eliminator::visit(Input &node) {}
+void Dead_code_eliminator::visit(Assignment_expr &node) {}
+void Dead_code_eliminator::visit(Binary_operator &node) {}
+void Dead_code_eliminator::visit(Unary_operator &node) {}
+void Dead_code_eliminator::visit(Number &node) {}
+void Dead_code_eliminator::visit(Variable &node) {}
+void Dead_code_eliminator::visit(Func &node) {}
+void Dead_code_eliminator::visit(Call &node) {}
+
+Statement_ptr Dead_code_eliminator::eliminate(Statement &stmt) {
+    stmt.accept(*this);
+    return result_;
+}
+
+void Dead_code_eliminator::eliminate(StmtList &stmts) {
+    StmtList kept;
+    kept.reserve(stmts.size());
+
+    for (auto *stmt : stmts) {
+        if (auto *replacement = eliminate(*stmt))
+            kept.push_back(replacement);
+    }
+
+    stmts = std::move(kept);
+}
+
+Statement_ptr Dead_code_eliminator::eliminate_or_empty(Statement &stmt) {
+    if (auto *replacement = eliminate(stmt))
+        return replacement;
+    if (auto *empty = dynamic_cast<Empty_stmt *>(&stmt))
+        return empty;
+    return pool_.make<Empty_stmt>();
+}
+
+} // namespace language
@@ -1,28 +1,146 @@
 #include "driver.hpp"
+#include "ast_rebuilder.hpp"
+#include "bytecode_compiler.hpp"
+#include "checker.hpp"
+#include "closure_engine.hpp"
 #include "dump_path_gen.hpp"
+#include "flat_ast_builder.hpp"
+#include "flat_simulator.hpp"
 #include "graph_dump.hpp"
+#include "input_reader.hpp"
+#include "jit_compiler.hpp"
 #include "lexer.hpp"
+#include "memo_table.hpp"
 #include "my_parser.hpp"
 #include "node.hpp"
+#include "optimizer.hpp"
+#include "output_sink.hpp"
+#include "options.hpp"
+#include "shape_classifier.hpp"
 #include "parser.hpp"
+#include "profiler.hpp"
+#include "program_cache.hpp"
+#include "purity_analyzer.hpp"
 #include "simulator.hpp"
+#include "translation_unit.hpp"
+#include "vm.hpp"
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unistd.h>
 
-void driver(int argc, const char **argv) {
-    if (argc < 2) {
-        throw std::runtime_error(std::string("Usage: ") + argv[0] +
-                                 " <program_file>");
+namespace {
+
+#ifdef GRAPH_DUMP
+std::ofstream open_graph_dump() {
+    const auto paths = language::make_dump_paths();
+    const std::string gv_file = paths.gv.string();
+    const std::string svg_file = paths.svg.string();
+    // dot dump/dump.gv -Tsvg -o dump/dump.svg
+
+    std::ofstream gv(gv_file);
+    if (!gv) {
+        throw std::runtime_error("unable to open gv file\n");
     }
+    return gv;
+}
+#endif
 
-    std::ifstream program_file(argv[1]);
-    if (!program_file) {
-        throw std::runtime_error("Cannot open program file\n");
+void report_memo(std::size_t pure, const language::Memo_table *memo) {
+    std::cerr << "memo: " << pure << " pure functions";
+    if (!memo) {
+        std::cerr << '\n';
+        return;
     }
-    language::Lexer scanner(&program_file, &std::cout);
 
-    language::My_parser parser(&scanner, argv[1]);
+    const auto &stats = memo->get_stats();
+    const auto lookups = stats.hits + stats.misses;
+    std::cerr << ", " << stats.hits << " hits, " << stats.misses
+              << " misses, " << stats.evictions << " evictions in "
+              << memo->capacity() << " entries, "
+              << (lookups ? 100.0 * stats.hits / lookups : 0.0)
+              << "% hit rate\n";
+}
+
+// Only builds that dump the graph have a use for its heat.
+bool wants_heat(const language::Options &options) {
+#ifdef GRAPH_DUMP
+    return options.dump_heat || options.dump_prune;
+#else
+    (void)options;
+    return false;
+#endif
+}
+
+// Returns the execution heat of the program when the graph dump wants it.
+std::optional<language::Heat_overlay>
+run_simulator(language::Program &root, language::Output_sink &output,
+              language::Input_reader &input, const language::Options &options,
+              const language::Source_file &source) {
+    language::classify_shapes(root);
 
-    int result = parser.parse();
+    std::optional<language::Memo_table> memo;
+    std::size_t pure = 0;
+    if (options.memo_size != 0 && !root.get_functions().empty()) {
+        pure = language::mark_pure_functions(root);
+        if (pure != 0)
+            memo.emplace(options.memo_size, options.memo_eviction);
+    }
+
+    std::optional<language::Heat_overlay> heat;
+    auto *const memo_table = memo ? &*memo : nullptr;
+    if (options.profile || wants_heat(options)) {
+        language::Profiler profiler{output, input, options.max_call_depth,
+                                    memo_table};
+        root.accept(profiler);
+        output.flush();
+        if (options.profile)
+            profiler.report(std::cerr, source);
+        if (wants_heat(options))
+            heat.emplace(profiler,
+                         options.dump_heat.value_or(language::Heat_mode::Count),
+                         options.dump_prune);
+    } else {
+        language::Simulator simulator{output, input, options.max_call_depth,
+                                      memo_table};
+        root.accept(simulator);
+    }
+
+    if (options.memo_stats)
+        report_memo(pure, memo ? &*memo : nullptr);
+    return heat;
+}
+
+// Tokenizes the whole program without parsing it and reports the throughput.
+void report_lexing(language::Lexer &scanner, std::size_t bytes) {
+#ifdef SIMD_LEXER
+    const char *const lexer_name = language::Simd_lexer::simd_level();
+#else
+    const char *const lexer_name = "flex";
+#endif
+    std::size_t tokens = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (scanner.yylex() != 0)
+        ++tokens;
+    const std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    const double seconds = elapsed.count();
+    std::cerr << "lexer (" << lexer_name << "): " << tokens << " tokens, "
+              << bytes << " bytes in " << seconds * 1e3 << " ms, "
+              << (seconds > 0 ? bytes / seconds / 1e9 : 0.0) << " GB/s\n";
+}
+
+language::Program &compile(language::Translation_unit &unit,
+                           const language::Options &options) {
+    auto &parser = unit.parser();
+
+    int result = unit.parse();
 
     language::program_ptr root = parser.get_root();
 
@@ -36,20 +154,190 @@ void driver(int argc, const char **argv) {
         throw std::runtime_error("unknown error\n");
     }
 
-    language::Simulator simulator{};
-    root->accept(simulator);
+    if (options.optimize) {
+        const auto stats = language::optimize(*root, parser.get_pool());
+        if (options.optimizer_stats) {
+            std::cerr << "optimizer: " << stats.folded_nodes
+                      << " expressions folded, " << stats.removed_nodes
+                      << " nodes removed, " << stats.hoisted_expressions
+                      << " loop invariants hoisted\n";
+        }
+    }
 
-#ifdef GRAPH_DUMP
-    // ____________GRAPH DUMP___________ //
-    const auto paths = language::make_dump_paths();
-    const std::string gv_file = paths.gv.string();
-    const std::string svg_file = paths.svg.string();
-    // dot dump/dump.gv -Tsvg -o dump/dump.svg
+    return *root;
+}
 
-    std::ofstream gv(gv_file);
-    if (!gv) {
-        throw std::runtime_error("unable to open gv file\n");
+void report_cache(language::Cache_status status,
+                  const std::filesystem::path &entry) {
+    const char *const outcomes[] = {"hit", "miss", "stale entry",
+                                    "corrupt entry"};
+    std::cerr << "cache: " << outcomes[static_cast<int>(status)] << ' '
+              << entry.string() << '\n';
+}
+
+// A program the cache cannot hold still runs, the failure is only reported.
+std::optional<language::Flat_ast>
+store_in_cache(const language::Program_cache &cache,
+               const language::Cache_key &key, language::Program &root) {
+    try {
+        auto flat_ast = language::Flat_ast_builder{}.build(root);
+        cache.store(key, flat_ast);
+        return flat_ast;
+    } catch (const std::exception &error) {
+        std::cerr << "cache: entry not stored: " << error.what() << '\n';
+        return std::nullopt;
+    }
+}
+
+void check(const language::Options &options) {
+    const auto jobs =
+        options.jobs ? options.jobs
+                     : std::max(1u, std::thread::hardware_concurrency());
+    const auto results = language::check_programs(options.program_files, jobs,
+                                                  options.use_huge_pages);
+
+    std::size_t failed = 0;
+    for (const auto &result : results) {
+        std::cout << result.output;
+        failed += !result.ok;
     }
-    language::graph_dump(gv, *root);
+
+    if (failed) {
+        throw std::runtime_error(std::to_string(failed) + " of " +
+                                 std::to_string(results.size()) +
+                                 " programs failed to compile\n");
+    }
+}
+
+} // namespace
+
+void driver(int argc, const char **argv) {
+    const auto options = language::parse_options(argc, argv);
+
+    if (options.check) {
+        check(options);
+        return;
+    }
+
+    language::Translation_unit unit{options.program_files.front(), std::cerr,
+                                    options.use_huge_pages};
+
+    if (options.lex_only) {
+        report_lexing(unit.scanner(), unit.source().text().size());
+        return;
+    }
+
+    auto &parser = unit.parser();
+    language::program_ptr root = nullptr;
+    std::optional<language::Flat_ast> flat_ast;
+
+    std::optional<language::Program_cache> cache;
+    language::Cache_key cache_key{};
+    // Cached programs have no source positions to profile.
+    if (!options.cache_dir.empty() && !options.profile) {
+        cache.emplace(options.cache_dir);
+        cache_key = language::Program_cache::key(unit.source().text(),
+                                                 options.optimize);
+        auto lookup = cache->load(cache_key);
+        if (options.cache_stats)
+            report_cache(lookup.status, cache->entry_path(cache_key));
+        flat_ast = std::move(lookup.program);
+    }
+
+    if (flat_ast) {
+        // The flat engine runs the mapped entry as it is.
+        if (options.engine != language::Engine::Flat || wants_heat(options))
+            root = &language::Ast_rebuilder{*flat_ast, parser.get_pool(),
+                                            parser.symbols}
+                        .rebuild();
+    } else {
+        root = &compile(unit, options);
+        // The flat AST has no functions, so programs with them stay out of
+        // the cache.
+        if (cache && root->get_functions().empty())
+            flat_ast = store_in_cache(*cache, cache_key, *root);
+        else if (cache && options.cache_stats)
+            std::cerr << "cache: entry not stored: programs with functions "
+                         "are not cached\n";
+    }
+
+    if (options.arena_stats) {
+        const auto &pool = parser.get_pool();
+        std::cerr << "arena: " << pool.node_count() << " nodes, "
+                  << pool.bytes_used() << " bytes used, "
+                  << pool.bytes_reserved() << " bytes reserved in "
+                  << pool.chunk_count() << " chunks\n";
+    }
+
+    language::Output_sink output{
+        STDOUT_FILENO,
+        options.flush_policy.value_or(
+            language::Output_sink::default_policy(STDOUT_FILENO)),
+        options.flush_size};
+
+    auto input = options.input_file.empty()
+                     ? std::make_unique<language::Input_reader>(STDIN_FILENO)
+                     : std::make_unique<language::Input_reader>(
+                           options.input_file);
+
+    // Only the Simulator runs functions and profiles.
+    auto engine = options.engine;
+    if (options.profile || wants_heat(options) ||
+        (root && !root->get_functions().empty()))
+        engine = language::Engine::Simulator;
+
+    std::optional<language::Heat_overlay> heat;
+    switch (engine) {
+    case language::Engine::Simulator:
+        heat = run_simulator(*root, output, *input, options, unit.source());
+        break;
+    case language::Engine::Vm: {
+        const auto bytecode = language::Bytecode_compiler{}.compile(*root);
+        language::Vm vm{bytecode, output, *input};
+        vm.run();
+        break;
+    }
+    case language::Engine::Closure: {
+        const language::Closure_engine closure{*root, output, *input};
+        closure.run();
+        break;
+    }
+    case language::Engine::Jit: {
+        try {
+            language::Jit_program program{
+                language::Jit_compiler{}.compile(*root),
+                root->get_slot_count(), output, *input};
+            program.run();
+        } catch (const language::Jit_unsupported &) {
+            run_simulator(*root, output, *input, options, unit.source());
+        }
+        break;
+    }
+    case language::Engine::Flat: {
+        if (!flat_ast)
+            flat_ast = language::Flat_ast_builder{}.build(*root);
+        if (options.arena_stats) {
+            std::cerr << "flat ast: " << flat_ast->size() << " nodes, "
+                      << flat_ast->bytes_used() << " bytes used\n";
+        }
+
+        language::Flat_simulator simulator{*flat_ast, output, *input};
+        simulator.run();
+        output.flush();
+
+#ifdef GRAPH_DUMP
+        auto gv = open_graph_dump();
+        language::graph_dump(gv, *flat_ast);
+#endif
+        return;
+    }
+    }
+
+    output.flush();
+
+#ifdef GRAPH_DUMP
+    // ____________GRAPH DUMP___________ //
+    auto gv = open_graph_dump();
+    language::graph_dump(gv, *root, heat ? &*heat : nullptr);
 #endif
 }
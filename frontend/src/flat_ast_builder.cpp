@@ -0,0 +1,200 @@
+#include "flat_ast_builder.hpp"
+#include "node.hpp"
+#include "symbol_table.hpp"
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace language {
+
+Flat_ast Flat_ast_builder::build(Program &program) {
+    arrays_ = Arrays{};
+    slot_names_.assign(program.get_slot_count(), name_t_sv{});
+    symbols_ = &program.get_symbols();
+
+    program.accept(*this);
+
+    arrays_.name_offsets.reserve(slot_names_.size() + 1);
+    arrays_.name_offsets.push_back(0);
+    for (const auto name : slot_names_) {
+        arrays_.names.insert(arrays_.names.end(), name.begin(), name.end());
+        arrays_.name_offsets.push_back(arrays_.names.size());
+    }
+
+    auto storage = std::make_shared<const Arrays>(std::move(arrays_));
+    const Flat_ast::Layout layout{
+        storage->kinds,
+        storage->ops,
+        storage->first,
+        storage->second,
+        storage->children,
+        storage->name_offsets,
+        {storage->names.data(), storage->names.size()}};
+    return Flat_ast{layout, std::move(storage)};
+}
+
+void Flat_ast_builder::visit(Program &node) {
+    const auto id = add_node(Node_kind::Program);
+
+    lower_stmts(id, node.get_stmts());
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(Block_stmt &node) {
+    const auto id = add_node(Node_kind::Block_stmt);
+
+    lower_stmts(id, node.get_stmts());
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(Empty_stmt &node) {
+    result_ = add_node(Node_kind::Empty_stmt);
+}
+
+void Flat_ast_builder::visit(Assignment_stmt &node) {
+    const auto id = add_node(Node_kind::Assignment_stmt);
+    const auto *variable = node.get_variable();
+
+    const auto value = lower(node.get_value());
+
+    name_slot(*variable);
+    arrays_.first[id] = variable->get_slot();
+    arrays_.second[id] = value;
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(Assignment_expr &node) {
+    const auto id = add_node(Node_kind::Assignment_expr);
+    const auto *variable = node.get_variable();
+
+    const auto value = lower(node.get_value());
+
+    name_slot(*variable);
+    arrays_.first[id] = variable->get_slot();
+    arrays_.second[id] = value;
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(If_stmt &node) {
+    const auto id = add_node(Node_kind::If_stmt);
+
+    const auto condition = lower(node.get_condition());
+    const auto then_branch = lower(node.then_branch());
+    const auto else_branch = node.contains_else_branch()
+                                 ? lower(node.else_branch())
+                                 : Flat_ast::no_node;
+
+    arrays_.first[id] = condition;
+    arrays_.second[id] = arrays_.children.size();
+    arrays_.children.push_back(then_branch);
+    arrays_.children.push_back(else_branch);
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(While_stmt &node) {
+    const auto id = add_node(Node_kind::While_stmt);
+
+    const auto condition = lower(node.get_condition());
+    const auto body = lower(node.get_body());
+
+    arrays_.first[id] = condition;
+    arrays_.second[id] = body;
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(Print_stmt &node) {
+    const auto id = add_node(Node_kind::Print_stmt);
+
+    const auto value = lower(node.get_value());
+
+    arrays_.first[id] = value;
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(Return_stmt &node) {
+    throw std::runtime_error("functions are not supported by the flat AST");
+}
+
+void Flat_ast_builder::visit(Input &node) {
+    result_ = add_node(Node_kind::Input);
+}
+
+void Flat_ast_builder::visit(Binary_operator &node) {
+    const auto id = add_node(Node_kind::Binary_operator,
+                             static_cast<std::uint8_t>(node.get_operator()));
+
+    const auto left = lower(node.get_left());
+    const auto right = lower(node.get_right());
+
+    arrays_.first[id] = left;
+    arrays_.second[id] = right;
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(Unary_operator &node) {
+    const auto id = add_node(Node_kind::Unary_operator,
+                             static_cast<std::uint8_t>(node.get_operator()));
+
+    const auto operand = lower(node.get_operand());
+
+    arrays_.first[id] = operand;
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(Number &node) {
+    const auto id = add_node(Node_kind::Number);
+
+    arrays_.first[id] = static_cast<std::uint32_t>(node.get_value());
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(Variable &node) {
+    const auto id = add_node(Node_kind::Variable);
+
+    name_slot(node);
+    arrays_.first[id] = node.get_slot();
+    result_ = id;
+}
+
+void Flat_ast_builder::visit(Func &node) {
+    throw std::runtime_error("functions are not supported by the flat AST");
+}
+
+void Flat_ast_builder::visit(Call &node) {
+    throw std::runtime_error("calls are not supported by the flat AST");
+}
+
+// Nodes are appended before their children to keep the pre-order layout, so
+// child ids are lowered into locals before the parent's fields are written:
+// lowering may reallocate the arrays.
+node_id Flat_ast_builder::add_node(Node_kind kind, std::uint8_t op) {
+    arrays_.kinds.push_back(kind);
+    arrays_.ops.push_back(op);
+    arrays_.first.push_back(0);
+    arrays_.second.push_back(0);
+    return arrays_.kinds.size() - 1;
+}
+
+node_id Flat_ast_builder::lower(Node &node) {
+    node.accept(*this);
+    return result_;
+}
+
+void Flat_ast_builder::lower_stmts(node_id id, const StmtList &stmts) {
+    std::vector<node_id> children;
+    children.reserve(stmts.size());
+    for (auto *stmt : stmts)
+        children.push_back(lower(*stmt));
+
+    arrays_.first[id] = arrays_.children.size();
+    arrays_.second[id] = children.size();
+    arrays_.children.insert(arrays_.children.end(), children.begin(),
+                          children.end());
+}
+
+void Flat_ast_builder::name_slot(const Variable &variable) {
+    slot_names_[variable.get_slot()] =
+        symbols_->name(variable.get_symbol());
+}
+
+} // namespace language
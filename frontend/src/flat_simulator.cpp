@@ -0,0 +1,103 @@
+#include "flat_simulator.hpp"
+#include <stdexcept>
+
+namespace language {
+
+void Flat_simulator::execute(node_id id) {
+    switch (ast_.kind(id)) {
+    case Node_kind::Program:
+    case Node_kind::Block_stmt:
+        for (const auto stmt : ast_.stmts(id))
+            execute(stmt);
+        break;
+    case Node_kind::Empty_stmt:
+        break;
+    case Node_kind::Assignment_stmt:
+        slots_[ast_.slot(id)] = evaluate(ast_.value(id));
+        break;
+    case Node_kind::If_stmt:
+        if (evaluate(ast_.condition(id)))
+            execute(ast_.then_branch(id));
+        else if (const auto else_branch = ast_.else_branch(id);
+                 else_branch != Flat_ast::no_node)
+            execute(else_branch);
+        break;
+    case Node_kind::While_stmt:
+        while (evaluate(ast_.condition(id)))
+            execute(ast_.body(id));
+        break;
+    case Node_kind::Print_stmt:
+        out_.print(evaluate(ast_.value(id)));
+        break;
+    default:
+        throw std::runtime_error("expression used as a statement");
+    }
+}
+
+number_t Flat_simulator::evaluate(node_id id) {
+    switch (ast_.kind(id)) {
+    case Node_kind::Number:
+        return ast_.number(id);
+    case Node_kind::Variable:
+        return slots_[ast_.slot(id)];
+    case Node_kind::Assignment_expr:
+        return slots_[ast_.slot(id)] = evaluate(ast_.value(id));
+    case Node_kind::Input:
+        return in_.read_number();
+    case Node_kind::Unary_operator: {
+        const auto value = evaluate(ast_.operand(id));
+        switch (ast_.unary_operator(id)) {
+        case Unary_operators::Neg:
+            return -value;
+        case Unary_operators::Plus:
+            return value;
+        case Unary_operators::Not:
+            return !value;
+        }
+        throw std::runtime_error("Unknown unary operator");
+    }
+    case Node_kind::Binary_operator: {
+        const auto lhs = evaluate(ast_.left(id));
+        const auto rhs = evaluate(ast_.right(id));
+        switch (ast_.binary_operator(id)) {
+        case Binary_operators::Eq:
+            return lhs == rhs;
+        case Binary_operators::Neq:
+            return lhs != rhs;
+        case Binary_operators::Less:
+            return lhs < rhs;
+        case Binary_operators::LessEq:
+            return lhs <= rhs;
+        case Binary_operators::Greater:
+            return lhs > rhs;
+        case Binary_operators::GreaterEq:
+            return lhs >= rhs;
+        case Binary_operators::Add:
+            return lhs + rhs;
+        case Binary_operators::Sub:
+            return lhs - rhs;
+        case Binary_operators::Mul:
+            return lhs * rhs;
+        case Binary_operators::Div:
+            return lhs / rhs;
+        case Binary_operators::RemDiv:
+            return lhs % rhs;
+        case Binary_operators::And:
+            return lhs & rhs;
+        case Binary_operators::Xor:
+            return lhs ^ rhs;
+        case Binary_operators::Or:
+            return lhs | rhs;
+        case Binary_operators::LogOr:
+            return lhs || rhs;
+        case Binary_operators::LogAnd:
+            return lhs && rhs;
+        }
+        throw std::runtime_error("Unknown binary operator");
+    }
+    default:
+        throw std::runtime_error("statement used as an expression");
+    }
+}
+
+} // namespace language
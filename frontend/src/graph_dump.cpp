@@ -1,15 +1,177 @@
 #include "graph_dump.hpp"
+#include "flat_ast.hpp"
 #include "node.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
 #include <ostream>
+#include <vector>
 
 namespace language {
 
+namespace {
+
+const char *binary_operator_str(Binary_operators op) {
+    switch (op) {
+    case Binary_operators::Eq:
+        return "==";
+    case Binary_operators::Neq:
+        return "!=";
+    case Binary_operators::Less:
+        return "\\<";
+    case Binary_operators::LessEq:
+        return "\\<=";
+    case Binary_operators::Greater:
+        return "\\>";
+    case Binary_operators::GreaterEq:
+        return "\\>=";
+    case Binary_operators::Add:
+        return "+";
+    case Binary_operators::Sub:
+        return "-";
+    case Binary_operators::Mul:
+        return "*";
+    case Binary_operators::Div:
+        return "/";
+    case Binary_operators::RemDiv:
+        return "%";
+    case Binary_operators::And:
+        return "&";
+    case Binary_operators::Xor:
+        return "^";
+    case Binary_operators::Or:
+        return "\\|";
+    case Binary_operators::LogAnd:
+        return "\\&&";
+    case Binary_operators::LogOr:
+        return "\\|\\|";
+    }
+    return "";
+}
+
+const char *unary_operator_str(Unary_operators op) {
+    switch (op) {
+    case Unary_operators::Neg:
+        return "-";
+    case Unary_operators::Plus:
+        return "+";
+    case Unary_operators::Not:
+        return "!";
+    }
+    return "";
+}
+
+} // namespace
+
+Heat_overlay::Heat_overlay(const Profiler &profiler, Heat_mode mode,
+                           bool prune)
+    : mode_(mode), prune_(prune) {
+    const auto samples = profiler.get_samples();
+    for (const auto &[stmt, entry] : profiler.get_entries()) {
+        heat_[stmt] = {entry.count,
+                       samples ? double(entry.total_samples) / samples : 0.0};
+        max_count_ = std::max(max_count_, entry.count);
+    }
+    for (const auto &[condition, count] : profiler.get_conditions()) {
+        conditions_[condition] = count;
+        max_count_ = std::max(max_count_, count);
+    }
+}
+
+Heat_overlay::Heat Heat_overlay::heat_of(const Statement &stmt) const {
+    if (const auto *block = dynamic_cast<const Block_stmt *>(&stmt)) {
+        Heat heat;
+        for (const auto *inner : block->get_stmts()) {
+            if (!inner)
+                continue;
+            const auto inner_heat = heat_of(*inner);
+            heat.count = std::max(heat.count, inner_heat.count);
+            heat.time_share += inner_heat.time_share;
+        }
+        // Recursive calls charge a sample to statements of several levels.
+        heat.time_share = std::min(heat.time_share, 1.0);
+        return heat;
+    }
+
+    const auto it = heat_.find(&stmt);
+    return it == heat_.end() ? Heat{} : it->second;
+}
+
+Heat_overlay::Heat Heat_overlay::heat_of(const Expression &expr,
+                                         Heat enclosing) const {
+    enclosing.inherited_time = true;
+    if (const auto it = conditions_.find(&expr); it != conditions_.end())
+        enclosing.count = it->second;
+    else
+        enclosing.inherited_count = true;
+    return enclosing;
+}
+
+std::string Heat_overlay::color(Heat heat) const {
+    if (heat.count == 0)
+        return "lightgrey";
+
+    // Counts span orders of magnitude, so they are compared on a log scale.
+    const double hotness =
+        mode_ == Heat_mode::Count
+            ? std::log1p(double(heat.count)) /
+                  std::log1p(double(std::max(max_count_, heat.count)))
+            : heat.time_share;
+
+    char hsv[32];
+    std::snprintf(hsv, sizeof(hsv), "\"%.3f %.3f 1.000\"",
+                  0.16 * (1 - hotness), 0.15 + 0.75 * hotness);
+    return hsv;
+}
+
+std::string Graph_dump::fill(const char *type_color) const {
+    return overlay_ ? overlay_->color(heat_) : type_color;
+}
+
+std::string Graph_dump::heat_label() const {
+    if (!overlay_)
+        return "";
+
+    // Inherited values are upper bounds.
+    const auto bound = [](bool inherited, const std::string &value) {
+        return inherited ? "≤" + value + " (inherited)" : value;
+    };
+
+    char time[16];
+    std::snprintf(time, sizeof(time), "%.1f%%", 100 * heat_.time_share);
+    return "| runs: " +
+           bound(heat_.inherited_count, std::to_string(heat_.count)) +
+           " | time: " + bound(heat_.inherited_time, time) + " ";
+}
+
+void Graph_dump::descend(const Node &from, Node &to) {
+    auto heat = heat_;
+    if (overlay_) {
+        // An empty block has nothing measured, it inherits its parent's heat.
+        if (const auto *stmt = dynamic_cast<const Statement *>(&to)) {
+            const auto *block = dynamic_cast<const Block_stmt *>(stmt);
+            if (!block || !block->get_stmts().empty())
+                heat = overlay_->heat_of(*stmt);
+            else
+                heat.inherited_count = heat.inherited_time = true;
+        } else if (const auto *expr = dynamic_cast<const Expression *>(&to)) {
+            heat = overlay_->heat_of(*expr, heat);
+        }
+        if (overlay_->prunes() && heat.count == 0)
+            return;
+    }
+
+    emit_edge(&from, &to);
+    Graph_dump child{gv_, &from, symbols_, overlay_, heat};
+    to.accept(child);
+}
+
 void Graph_dump::visit(Program &node) {
     const auto &stmts = node.get_stmts();
     const std::size_t size = stmts.size();
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=salmon"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("salmon")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ Program"
         << " | addr: " << &node << " | parent: " << parent_ << "| { ";
 
@@ -18,14 +180,11 @@ void Graph_dump::visit(Program &node) {
         if (i + 1 < size)
             gv_ << " | ";
     }
-    gv_ << " } }\"" << "];\n";
+    gv_ << " } " << heat_label() << "}\"];\n";
 
     for (auto *stmt : stmts) {
-        if (!stmt)
-            continue;
-        emit_edge(&node, stmt);
-        Graph_dump child{gv_, &node};
-        stmt->accept(child);
+        if (stmt)
+            descend(node, *stmt);
     }
 }
 
@@ -34,7 +193,7 @@ void Graph_dump::visit(Block_stmt &node) {
     const std::size_t size = stmts.size();
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=lightgoldenrod1"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("lightgoldenrod1")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ Block"
         << " | addr: " << &node << " | parent: " << parent_ << "| { ";
 
@@ -43,22 +202,20 @@ void Graph_dump::visit(Block_stmt &node) {
         if (i + 1 < size)
             gv_ << " | ";
     }
-    gv_ << " } }\"" << "];\n";
+    gv_ << " } " << heat_label() << "}\"];\n";
 
     for (auto *stmt : stmts) {
-        if (!stmt)
-            continue;
-        emit_edge(&node, stmt);
-        Graph_dump child{gv_, &node};
-        stmt->accept(child);
+        if (stmt)
+            descend(node, *stmt);
     }
 }
 
 void Graph_dump::visit(Empty_stmt &node) {
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=lavenderblush1"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("lavenderblush1")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ Empty"
-        << " | addr: " << &node << " | parent: " << parent_ << "}\"" << "];\n";
+        << " | addr: " << &node << " | parent: " << parent_ << heat_label()
+        << "}\"];\n";
 }
 
 void Graph_dump::visit(Assignment_stmt &node) {
@@ -66,21 +223,15 @@ void Graph_dump::visit(Assignment_stmt &node) {
     auto *val = &node.get_value();
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=plum"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("plum")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; "
         << "label=\"{ Assignment" << " | addr: " << &node
         << " | parent: " << parent_ << "| { left: " << var
-        << " | right: " << val << " } }\"" << "];\n";
+        << " | right: " << val << " } " << heat_label() << "}\"];\n";
 
-    if (var) {
-        emit_edge(&node, var);
-        Graph_dump child{gv_, &node};
-        var->accept(child);
-    }
-
-    emit_edge(&node, val);
-    Graph_dump child{gv_, &node};
-    val->accept(child);
+    if (var)
+        descend(node, *var);
+    descend(node, *val);
 }
 
 void Graph_dump::visit(Assignment_expr &node) {
@@ -88,21 +239,15 @@ void Graph_dump::visit(Assignment_expr &node) {
     auto *val = &node.get_value();
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=plum"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("plum")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; "
         << "label=\"{ Assignment expr" << " | addr: " << &node
         << " | parent: " << parent_ << "| { left: " << var
-        << " | right: " << val << " } }\"" << "];\n";
-
-    if (var) {
-        emit_edge(&node, var);
-        Graph_dump child{gv_, &node};
-        var->accept(child);
-    }
+        << " | right: " << val << " } " << heat_label() << "}\"];\n";
 
-    emit_edge(&node, val);
-    Graph_dump child{gv_, &node};
-    val->accept(child);
+    if (var)
+        descend(node, *var);
+    descend(node, *val);
 }
 
 void Graph_dump::visit(While_stmt &node) {
@@ -110,22 +255,14 @@ void Graph_dump::visit(While_stmt &node) {
     auto *body = &node.get_body();
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=turquoise"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("turquoise")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ While"
         << " | addr: " << &node << " | parent: " << parent_
-        << "| { left: " << cond << " | right: " << body << " } }\"" << "];\n";
-
-    emit_edge(&node, cond);
-    {
-        Graph_dump child{gv_, &node};
-        cond->accept(child);
-    }
+        << "| { left: " << cond << " | right: " << body << " } "
+        << heat_label() << "}\"];\n";
 
-    emit_edge(&node, body);
-    {
-        Graph_dump child{gv_, &node};
-        body->accept(child);
-    }
+    descend(node, *cond);
+    descend(node, *body);
 }
 
 void Graph_dump::visit(If_stmt &node) {
@@ -135,171 +272,100 @@ void Graph_dump::visit(If_stmt &node) {
         node.contains_else_branch() ? &node.else_branch() : nullptr;
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=turquoise"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("turquoise")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ If"
         << " | addr: " << &node << " | parent: " << parent_
         << "| { cond: " << cond << " | then: " << then_b
-        << " | else: " << else_b << " } }\"" << "];\n";
-
-    emit_edge(&node, cond);
-    {
-        Graph_dump child{gv_, &node};
-        cond->accept(child);
-    }
+        << " | else: " << else_b << " } " << heat_label() << "}\"];\n";
 
-    emit_edge(&node, then_b);
-    {
-        Graph_dump child{gv_, &node};
-        then_b->accept(child);
-    }
+    descend(node, *cond);
+    descend(node, *then_b);
 
-    if (else_b) {
-        emit_edge(&node, else_b);
-        Graph_dump child{gv_, &node};
-        else_b->accept(child);
-    }
+    if (else_b)
+        descend(node, *else_b);
 }
 
 void Graph_dump::visit(Input &node) {
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=lavenderblush1"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("lavenderblush1")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ Input"
-        << " | addr: " << &node << " | parent: " << parent_ << "}\"" << "];\n";
+        << " | addr: " << &node << " | parent: " << parent_ << heat_label()
+        << "}\"];\n";
 }
 
 void Graph_dump::visit(Print_stmt &node) {
     auto *val = &node.get_value();
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=darkorange"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("darkorange")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ Print"
         << " | addr: " << &node << " | parent: " << parent_
-        << " | value: " << val << "}\"" << "];\n";
+        << " | value: " << val << heat_label() << "}\"];\n";
 
-    emit_edge(&node, val);
-    Graph_dump child{gv_, &node};
-    val->accept(child);
+    descend(node, *val);
+}
+
+void Graph_dump::visit(Return_stmt &node) {
+    auto *val = &node.get_value();
+
+    gv_ << "    node_" << &node
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("gold")
+        << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ Return"
+        << " | addr: " << &node << " | parent: " << parent_
+        << " | value: " << val << heat_label() << "}\"];\n";
+
+    descend(node, *val);
 }
 
 void Graph_dump::visit(Binary_operator &node) {
-    const char *op_str = "";
-    switch (node.get_operator()) {
-    case Binary_operators::Eq:
-        op_str = "==";
-        break;
-    case Binary_operators::Neq:
-        op_str = "!=";
-        break;
-    case Binary_operators::Less:
-        op_str = "\\<";
-        break;
-    case Binary_operators::LessEq:
-        op_str = "\\<=";
-        break;
-    case Binary_operators::Greater:
-        op_str = "\\>";
-        break;
-    case Binary_operators::GreaterEq:
-        op_str = "\\>=";
-        break;
-    case Binary_operators::Add:
-        op_str = "+";
-        break;
-    case Binary_operators::Sub:
-        op_str = "-";
-        break;
-    case Binary_operators::Mul:
-        op_str = "*";
-        break;
-    case Binary_operators::Div:
-        op_str = "/";
-        break;
-    case Binary_operators::RemDiv:
-        op_str = "%";
-        break;
-    case Binary_operators::And:
-        op_str = "&";
-        break;
-    case Binary_operators::Xor:
-        op_str = "^";
-        break;
-    case Binary_operators::Or:
-        op_str = "\\|";
-        break;
-    case Binary_operators::LogAnd:
-        op_str = "\\&&";
-        break;
-    case Binary_operators::LogOr:
-        op_str = "\\|\\|";
-        break;
-    }
+    const char *op_str = binary_operator_str(node.get_operator());
 
     auto *l = &node.get_left();
     auto *r = &node.get_right();
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=lightsteelblue1"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("lightsteelblue1")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; "
         << "label=\"{ Binary operator" << " | addr: " << &node
         << " | parent: " << parent_ << " | operator: " << op_str
-        << " | { left: " << l << " | right: " << r << " } }\"" << "];\n";
-
-    emit_edge(&node, l);
-    {
-        Graph_dump child{gv_, &node};
-        l->accept(child);
-    }
+        << " | { left: " << l << " | right: " << r << " } " << heat_label()
+        << "}\"];\n";
 
-    emit_edge(&node, r);
-    {
-        Graph_dump child{gv_, &node};
-        r->accept(child);
-    }
+    descend(node, *l);
+    descend(node, *r);
 }
 
 void Graph_dump::visit(Unary_operator &node) {
-    const char *op_str = "";
-    switch (node.get_operator()) {
-    case Unary_operators::Neg:
-        op_str = "-";
-        break;
-    case Unary_operators::Plus:
-        op_str = "+";
-        break;
-    case Unary_operators::Not:
-        op_str = "!";
-        break;
-    }
+    const char *op_str = unary_operator_str(node.get_operator());
 
     auto *opnd = &node.get_operand();
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=lightsteelblue1"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("lightsteelblue1")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; "
         << "label=\"{ Unary operator" << " | addr: " << &node
         << " | parent: " << parent_ << " | operator: " << op_str
-        << "| operand: " << opnd << " }\"" << "];\n";
+        << "| operand: " << opnd << " " << heat_label() << "}\"];\n";
 
-    emit_edge(&node, opnd);
-    Graph_dump child{gv_, &node};
-    opnd->accept(child);
+    descend(node, *opnd);
 }
 
 void Graph_dump::visit(Number &node) {
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=palegreen"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("palegreen")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ Number"
         << " | addr: " << &node << " | parent: " << parent_
-        << " | value: " << node.get_value() << " }\"" << "];\n";
+        << " | value: " << node.get_value() << " " << heat_label() << "}\"];\n";
 }
 
 void Graph_dump::visit(Variable &node) {
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=cornflowerblue"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("cornflowerblue")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; "
         << "label=\"{ Variable" << " | addr: " << &node
-        << " | parent: " << parent_ << " | name: " << node.get_name() << " }\""
-        << "];\n";
+        << " | parent: " << parent_
+        << " | name: " << symbols_.name(node.get_symbol()) << " "
+        << heat_label() << "}\"];\n";
 }
 
 void Graph_dump::visit(Func &node) {
@@ -309,46 +375,187 @@ void Graph_dump::visit(Func &node) {
     const char *name_str = name_opt ? "named" : "anonymous";
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=khaki1"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("khaki1")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ Func"
         << " | addr: " << &node << " | parent: " << parent_ << " | "
         << name_str;
 
     if (name_opt) {
-        gv_ << " | name: " << *name_opt;
+        gv_ << " | name: " << symbols_.name(*name_opt);
     }
 
     gv_ << " | params_count: " << node.get_params().size()
-        << " | body: " << body << " }\"" << "];\n";
+        << " | body: " << body << " " << heat_label() << "}\"];\n";
 
-    emit_edge(&node, body);
-    Graph_dump child{gv_, &node};
-    body->accept(child);
+    descend(node, *body);
 }
 
 void Graph_dump::visit(Call &node) {
     auto *t = &node.get_target();
 
     gv_ << "    node_" << &node
-        << "[shape=Mrecord; style=filled; fillcolor=lightskyblue1"
+        << "[shape=Mrecord; style=filled; fillcolor=" << fill("lightskyblue1")
         << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ Call"
         << " | addr: " << &node << " | parent: " << parent_
-        << " | target: " << t << " | argc: " << node.get_args().size() << " }\""
-        << "];\n";
+        << " | target: " << t << " | argc: " << node.get_args().size() << " "
+        << heat_label() << "}\"];\n";
 
-    emit_edge(&node, t);
-    {
-        Graph_dump child{gv_, &node};
-        t->accept(child);
-    }
+    descend(node, *t);
 
     for (auto *a : node.get_args()) {
-        if (!a)
-            continue;
-        emit_edge(&node, a);
-        Graph_dump child{gv_, &node};
-        a->accept(child);
+        if (a)
+            descend(node, *a);
+    }
+}
+
+namespace {
+
+const char *flat_node_color(Node_kind kind) {
+    switch (kind) {
+    case Node_kind::Program:
+        return "salmon";
+    case Node_kind::Block_stmt:
+        return "lightgoldenrod1";
+    case Node_kind::Assignment_stmt:
+    case Node_kind::Assignment_expr:
+        return "plum";
+    case Node_kind::If_stmt:
+    case Node_kind::While_stmt:
+        return "turquoise";
+    case Node_kind::Print_stmt:
+        return "darkorange";
+    case Node_kind::Binary_operator:
+    case Node_kind::Unary_operator:
+        return "lightsteelblue1";
+    case Node_kind::Number:
+        return "palegreen";
+    case Node_kind::Variable:
+        return "cornflowerblue";
+    default:
+        return "lavenderblush1";
+    }
+}
+
+const char *flat_node_title(Node_kind kind) {
+    switch (kind) {
+    case Node_kind::Program:
+        return "Program";
+    case Node_kind::Block_stmt:
+        return "Block";
+    case Node_kind::Empty_stmt:
+        return "Empty";
+    case Node_kind::Assignment_stmt:
+        return "Assignment";
+    case Node_kind::Assignment_expr:
+        return "Assignment expr";
+    case Node_kind::If_stmt:
+        return "If";
+    case Node_kind::While_stmt:
+        return "While";
+    case Node_kind::Print_stmt:
+        return "Print";
+    case Node_kind::Input:
+        return "Input";
+    case Node_kind::Binary_operator:
+        return "Binary operator";
+    case Node_kind::Unary_operator:
+        return "Unary operator";
+    case Node_kind::Number:
+        return "Number";
+    case Node_kind::Variable:
+        return "Variable";
+    }
+    return "";
+}
+
+template <typename F>
+void for_each_child(const Flat_ast &ast, node_id id, F &&f) {
+    switch (ast.kind(id)) {
+    case Node_kind::Program:
+    case Node_kind::Block_stmt:
+        for (const auto stmt : ast.stmts(id))
+            f(stmt);
+        break;
+    case Node_kind::Assignment_stmt:
+    case Node_kind::Assignment_expr:
+    case Node_kind::Print_stmt:
+        f(ast.value(id));
+        break;
+    case Node_kind::If_stmt:
+        f(ast.condition(id));
+        f(ast.then_branch(id));
+        if (ast.else_branch(id) != Flat_ast::no_node)
+            f(ast.else_branch(id));
+        break;
+    case Node_kind::While_stmt:
+        f(ast.condition(id));
+        f(ast.body(id));
+        break;
+    case Node_kind::Binary_operator:
+        f(ast.left(id));
+        f(ast.right(id));
+        break;
+    case Node_kind::Unary_operator:
+        f(ast.operand(id));
+        break;
+    default:
+        break;
     }
 }
 
+} // namespace
+
+void graph_dump(std::ostream &gv, const Flat_ast &ast) {
+    gv << "digraph G {\n"
+       << "    rankdir=TB;\n"
+       << "    node [style=filled, fontname=\"Helvetica\", fontcolor=darkblue, "
+       << "fillcolor=peachpuff, color=\"#252A34\", penwidth=2.5];\n"
+       << "    bgcolor=\"lemonchiffon\";\n\n";
+
+    // Nodes are stored in pre-order, so a parent always precedes its children
+    // and one linear pass over the arrays emits the whole graph.
+    std::vector<node_id> parents(ast.size(), Flat_ast::no_node);
+
+    for (node_id id = 0; id < ast.size(); ++id) {
+        const auto kind = ast.kind(id);
+
+        gv << "    node_" << id << "[shape=Mrecord; style=filled; fillcolor="
+           << flat_node_color(kind)
+           << "; color=\"#000000\"; fontcolor=\"#000000\"; " << "label=\"{ "
+           << flat_node_title(kind) << " | id: " << id << " | parent: ";
+        if (parents[id] == Flat_ast::no_node)
+            gv << "none";
+        else
+            gv << parents[id];
+
+        switch (kind) {
+        case Node_kind::Assignment_stmt:
+        case Node_kind::Assignment_expr:
+        case Node_kind::Variable:
+            gv << " | name: " << ast.slot_name(ast.slot(id));
+            break;
+        case Node_kind::Binary_operator:
+            gv << " | operator: "
+               << binary_operator_str(ast.binary_operator(id));
+            break;
+        case Node_kind::Unary_operator:
+            gv << " | operator: " << unary_operator_str(ast.unary_operator(id));
+            break;
+        case Node_kind::Number:
+            gv << " | value: " << ast.number(id);
+            break;
+        default:
+            break;
+        }
+        gv << " }\"" << "];\n";
+
+        for_each_child(ast, id, [&](node_id child) {
+            parents[child] = id;
+            gv << "    node_" << id << " -> node_" << child << ";\n";
+        });
+    }
+
+    gv << "\n}\n";
+}
+
 } // namespace language
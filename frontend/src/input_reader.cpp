@@ -0,0 +1,144 @@
+#include "input_reader.hpp"
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace language {
+
+namespace {
+
+bool is_space(char c) noexcept {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' ||
+           c == '\f';
+}
+
+// Longer tokens are reported truncated.
+constexpr std::size_t max_reported_token = 32;
+
+} // namespace
+
+Input_reader::Input_reader(int fd) : fd_(fd) { init(); }
+
+Input_reader::Input_reader(const std::string &path)
+    : fd_(open(path.c_str(), O_RDONLY | O_CLOEXEC)), owns_fd_(true) {
+    if (fd_ < 0)
+        throw std::runtime_error("cannot open input file " + path + ": " +
+                                 std::strerror(errno));
+    init();
+}
+
+Input_reader::~Input_reader() {
+    if (map_)
+        munmap(map_, map_size_);
+    if (owns_fd_)
+        close(fd_);
+}
+
+void Input_reader::init() {
+    struct stat info {};
+    const off_t offset = lseek(fd_, 0, SEEK_CUR);
+
+    if (fstat(fd_, &info) == 0 && S_ISREG(info.st_mode) && offset >= 0 &&
+        info.st_size > offset) {
+        map_size_ = static_cast<std::size_t>(info.st_size);
+        map_ = mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (map_ == MAP_FAILED) {
+            map_ = nullptr;
+        } else {
+            madvise(map_, map_size_, MADV_SEQUENTIAL);
+            pos_ = static_cast<const char *>(map_) + offset;
+            end_ = static_cast<const char *>(map_) + map_size_;
+            eof_ = true;
+            return;
+        }
+    }
+
+    buffer_.resize(block_size);
+    pos_ = end_ = buffer_.data();
+}
+
+number_t Input_reader::read_number() {
+    ++count_;
+    if (!skip_whitespace())
+        fail("unexpected end of input");
+
+    // Make sure the whole token is in memory.
+    const char *token_end = pos_;
+    for (;;) {
+        while (token_end != end_ && !is_space(*token_end))
+            ++token_end;
+        if (token_end != end_ || eof_)
+            break;
+
+        const auto scanned = token_end - pos_;
+        const bool more = refill();
+        token_end = pos_ + scanned;
+        if (!more)
+            break;
+    }
+
+    const std::string_view token(pos_, token_end - pos_);
+    pos_ = token_end;
+
+    const char *first = token.data();
+    const char *last = token.data() + token.size();
+    if (token.size() > 1 && *first == '+' && first[1] != '-')
+        ++first;
+
+    number_t value = 0;
+    const auto [ptr, error] = std::from_chars(first, last, value);
+    if (error == std::errc::result_out_of_range)
+        fail("number out of range '" + std::string(token) + "'");
+    if (error != std::errc{} || ptr != last)
+        fail("malformed number '" +
+             std::string(token.substr(0, max_reported_token)) + "'");
+
+    return value;
+}
+
+bool Input_reader::skip_whitespace() {
+    for (;;) {
+        while (pos_ != end_ && is_space(*pos_))
+            ++pos_;
+        if (pos_ != end_)
+            return true;
+        if (eof_ || !refill())
+            return false;
+    }
+}
+
+bool Input_reader::refill() {
+    const auto unread = static_cast<std::size_t>(end_ - pos_);
+    std::memmove(buffer_.data(), pos_, unread);
+    if (buffer_.size() - unread < block_size)
+        buffer_.resize(unread + block_size);
+
+    for (;;) {
+        const ssize_t got =
+            read(fd_, buffer_.data() + unread, buffer_.size() - unread);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got < 0)
+            throw std::runtime_error(std::string("cannot read input: ") +
+                                     std::strerror(errno));
+
+        pos_ = buffer_.data();
+        end_ = pos_ + unread + got;
+        if (got == 0)
+            eof_ = true;
+        return got != 0;
+    }
+}
+
+void Input_reader::fail(const std::string &what) const {
+    throw std::runtime_error("input value " + std::to_string(count_) + ": " +
+                             what);
+}
+
+} // namespace language
@@ -0,0 +1,347 @@
+#include "jit_compiler.hpp"
+#include "node.hpp"
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <optional>
+
+#if defined(__x86_64__) && defined(__linux__)
+#define JIT_SUPPORTED
+#include <sys/mman.h>
+#endif
+
+namespace language {
+
+namespace {
+
+using Alu = X86_64_emitter::Alu;
+using Condition = X86_64_emitter::Condition;
+
+// The generated code has no unwind information and keeps nothing that
+// needs destruction, so leaving it with longjmp is safe.
+[[noreturn]] void jit_abort(Jit_runtime *runtime) noexcept {
+    std::longjmp(runtime->abort, 1);
+}
+
+number_t jit_input(Jit_runtime *runtime) noexcept {
+    try {
+        return runtime->in->read_number();
+    } catch (...) {
+        runtime->error = std::current_exception();
+    }
+    jit_abort(runtime);
+}
+
+void jit_print(Jit_runtime *runtime, number_t value) noexcept {
+    try {
+        runtime->out->print(value);
+        return;
+    } catch (...) {
+        runtime->error = std::current_exception();
+    }
+    jit_abort(runtime);
+}
+
+std::optional<Alu> alu_of(Binary_operators op) {
+    switch (op) {
+    case Binary_operators::Add:
+        return Alu::Add;
+    case Binary_operators::Sub:
+        return Alu::Sub;
+    case Binary_operators::And:
+        return Alu::And;
+    case Binary_operators::Xor:
+        return Alu::Xor;
+    case Binary_operators::Or:
+        return Alu::Or;
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<Condition> condition_of(Binary_operators op) {
+    switch (op) {
+    case Binary_operators::Eq:
+        return Condition::Eq;
+    case Binary_operators::Neq:
+        return Condition::Neq;
+    case Binary_operators::Less:
+        return Condition::Less;
+    case Binary_operators::LessEq:
+        return Condition::LessEq;
+    case Binary_operators::Greater:
+        return Condition::Greater;
+    case Binary_operators::GreaterEq:
+        return Condition::GreaterEq;
+    default:
+        return std::nullopt;
+    }
+}
+
+} // namespace
+
+Jit_program::Jit_program(const std::vector<std::uint8_t> &code,
+                         slot_t slot_count, Output_sink &out,
+                         Input_reader &in)
+    : size_(code.size()), slots_(slot_count) {
+    runtime_.in = &in;
+    runtime_.out = &out;
+#ifdef JIT_SUPPORTED
+    code_ = mmap(nullptr, size_, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code_ == MAP_FAILED)
+        throw std::bad_alloc();
+
+    std::memcpy(code_, code.data(), size_);
+    if (mprotect(code_, size_, PROT_READ | PROT_EXEC) != 0) {
+        munmap(code_, size_);
+        throw std::runtime_error("unable to make JIT code executable");
+    }
+#else
+    throw Jit_unsupported("JIT is not supported on this platform");
+#endif
+}
+
+Jit_program::~Jit_program() {
+#ifdef JIT_SUPPORTED
+    munmap(code_, size_);
+#endif
+}
+
+void Jit_program::run() {
+    using entry_t = void (*)(number_t *, Jit_runtime *);
+    if (setjmp(runtime_.abort) == 0)
+        reinterpret_cast<entry_t>(code_)(slots_.data(), &runtime_);
+
+    if (runtime_.error)
+        std::rethrow_exception(runtime_.error);
+}
+
+bool Jit_compiler::is_supported() noexcept {
+#ifdef JIT_SUPPORTED
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::vector<std::uint8_t> Jit_compiler::compile(Program &program) {
+    if (!is_supported())
+        throw Jit_unsupported("JIT is not supported on this platform");
+
+    emitter_ = X86_64_emitter{};
+    depth_ = max_depth_ = 0;
+
+    const auto frame_patch = emitter_.prologue();
+    program.accept(*this);
+
+    // Keep rsp 16-byte aligned at helper calls.
+    const auto frame_size = (max_depth_ * 8 + 15) / 16 * 16;
+    emitter_.epilogue(frame_patch, static_cast<std::int32_t>(frame_size));
+
+    return emitter_.code();
+}
+
+void Jit_compiler::visit(Program &node) {
+    for (const auto &stmt : node.get_stmts())
+        stmt->accept(*this);
+}
+
+void Jit_compiler::visit(Block_stmt &node) {
+    for (const auto &stmt : node.get_stmts())
+        stmt->accept(*this);
+}
+
+void Jit_compiler::visit(Empty_stmt &node) {}
+
+void Jit_compiler::visit(Assignment_stmt &node) {
+    node.get_value().accept(*this);
+    emitter_.store_slot(node.get_variable()->get_slot());
+}
+
+void Jit_compiler::visit(Assignment_expr &node) {
+    node.get_value().accept(*this);
+    emitter_.store_slot(node.get_variable()->get_slot());
+}
+
+void Jit_compiler::visit(If_stmt &node) {
+    node.get_condition().accept(*this);
+    emitter_.test_eax();
+    const auto jump_to_else = emitter_.jz();
+
+    node.then_branch().accept(*this);
+
+    if (!node.contains_else_branch()) {
+        emitter_.patch_jump(jump_to_else, emitter_.here());
+        return;
+    }
+
+    const auto jump_to_end = emitter_.jmp();
+    emitter_.patch_jump(jump_to_else, emitter_.here());
+    node.else_branch().accept(*this);
+    emitter_.patch_jump(jump_to_end, emitter_.here());
+}
+
+void Jit_compiler::visit(While_stmt &node) {
+    const auto jump_to_condition = emitter_.jmp();
+
+    const auto body = emitter_.here();
+    node.get_body().accept(*this);
+
+    emitter_.patch_jump(jump_to_condition, emitter_.here());
+    node.get_condition().accept(*this);
+    emitter_.test_eax();
+    emitter_.patch_jump(emitter_.jnz(), body);
+}
+
+void Jit_compiler::visit(Print_stmt &node) {
+    node.get_value().accept(*this);
+    emitter_.call_helper(reinterpret_cast<const void *>(&jit_print), true);
+}
+
+void Jit_compiler::visit(Return_stmt &node) {
+    throw Jit_unsupported("functions are not supported by the JIT");
+}
+
+void Jit_compiler::visit(Input &node) {
+    emitter_.call_helper(reinterpret_cast<const void *>(&jit_input), false);
+}
+
+void Jit_compiler::visit(Binary_operator &node) {
+    const auto op = node.get_operator();
+    auto &right = node.get_right();
+
+    node.get_left().accept(*this);
+
+    if (auto *number = dynamic_cast<Number *>(&right);
+        number && apply_imm(op, number->get_value()))
+        return;
+
+    if (auto *variable = dynamic_cast<Variable *>(&right);
+        variable && apply_slot(op, variable->get_slot()))
+        return;
+
+    emitter_.store_temp(depth_++);
+    max_depth_ = std::max(max_depth_, depth_);
+    right.accept(*this);
+    --depth_;
+
+    emitter_.mov_ecx_eax();
+    emitter_.load_temp(depth_);
+    apply_ecx(op);
+}
+
+void Jit_compiler::visit(Unary_operator &node) {
+    node.get_operand().accept(*this);
+
+    switch (node.get_operator()) {
+    case Unary_operators::Neg:
+        emitter_.neg_eax();
+        break;
+    case Unary_operators::Plus:
+        break;
+    case Unary_operators::Not:
+        emitter_.test_eax();
+        emitter_.setcc_eax(Condition::Eq);
+        emitter_.movzx_eax_al();
+        break;
+    default:
+        throw std::runtime_error("Unknown unary operator");
+    }
+}
+
+void Jit_compiler::visit(Number &node) {
+    emitter_.mov_eax_imm(node.get_value());
+}
+
+void Jit_compiler::visit(Variable &node) {
+    emitter_.load_slot(node.get_slot());
+}
+
+void Jit_compiler::visit(Func &node) {
+    throw Jit_unsupported("functions are not supported by the JIT");
+}
+
+void Jit_compiler::visit(Call &node) {
+    throw Jit_unsupported("calls are not supported by the JIT");
+}
+
+void Jit_compiler::apply_ecx(Binary_operators op) {
+    if (const auto alu = alu_of(op)) {
+        emitter_.alu_ecx(*alu);
+        return;
+    }
+    if (const auto cond = condition_of(op)) {
+        emitter_.alu_ecx(Alu::Cmp);
+        compare(*cond);
+        return;
+    }
+
+    switch (op) {
+    case Binary_operators::Mul:
+        emitter_.imul_ecx();
+        break;
+    case Binary_operators::Div:
+        emitter_.idiv_ecx();
+        break;
+    case Binary_operators::RemDiv:
+        emitter_.idiv_ecx();
+        emitter_.mov_eax_edx();
+        break;
+    case Binary_operators::LogOr:
+    case Binary_operators::LogAnd:
+        emitter_.test_eax();
+        emitter_.setcc_eax(Condition::Neq);
+        emitter_.test_ecx();
+        emitter_.setcc_ecx(Condition::Neq);
+        if (op == Binary_operators::LogOr)
+            emitter_.or_al_cl();
+        else
+            emitter_.and_al_cl();
+        emitter_.movzx_eax_al();
+        break;
+    default:
+        throw std::runtime_error("Unknown binary operator");
+    }
+}
+
+bool Jit_compiler::apply_imm(Binary_operators op, number_t value) {
+    if (const auto alu = alu_of(op)) {
+        emitter_.alu_imm(*alu, value);
+        return true;
+    }
+    if (const auto cond = condition_of(op)) {
+        emitter_.alu_imm(Alu::Cmp, value);
+        compare(*cond);
+        return true;
+    }
+    if (op == Binary_operators::Mul) {
+        emitter_.imul_imm(value);
+        return true;
+    }
+    return false;
+}
+
+bool Jit_compiler::apply_slot(Binary_operators op, slot_t slot) {
+    if (const auto alu = alu_of(op)) {
+        emitter_.alu_slot(*alu, slot);
+        return true;
+    }
+    if (const auto cond = condition_of(op)) {
+        emitter_.alu_slot(Alu::Cmp, slot);
+        compare(*cond);
+        return true;
+    }
+    if (op == Binary_operators::Mul) {
+        emitter_.imul_slot(slot);
+        return true;
+    }
+    return false;
+}
+
+void Jit_compiler::compare(Condition cond) {
+    emitter_.setcc_eax(cond);
+    emitter_.movzx_eax_al();
+}
+
+} // namespace language
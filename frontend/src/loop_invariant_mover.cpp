@@ -0,0 +1,192 @@
+#include "loop_invariant_mover.hpp"
+#include "ast_walker.hpp"
+#include "dead_code_eliminator.hpp"
+#include "node.hpp"
+#include "slot_usage.hpp"
+#include "symbol_table.hpp"
+
+namespace language {
+
+namespace {
+
+constexpr name_t_sv temporary_name = "%invariant";
+
+class Invariance_checker final : public AST_walker {
+  private:
+    const std::vector<bool> &written_;
+    bool invariant_ = true;
+
+  public:
+    explicit Invariance_checker(const std::vector<bool> &written)
+        : written_(written) {}
+
+    bool is_invariant() const noexcept { return invariant_; }
+
+    using AST_walker::visit;
+
+    void visit(Variable &node) override {
+        if (written_[node.get_slot()])
+            invariant_ = false;
+    }
+};
+
+bool is_computation(const Expression &expression) {
+    return dynamic_cast<const Binary_operator *>(&expression) ||
+           dynamic_cast<const Unary_operator *>(&expression);
+}
+
+} // namespace
+
+void Invariant_hoister::visit(Program &node) {
+    for (const auto &stmt : node.get_stmts())
+        stmt->accept(*this);
+}
+
+void Invariant_hoister::visit(Block_stmt &node) {
+    for (const auto &stmt : node.get_stmts())
+        stmt->accept(*this);
+}
+
+void Invariant_hoister::visit(Empty_stmt &node) {}
+
+void Invariant_hoister::visit(Assignment_stmt &node) {
+    node.set_value(hoist(node.get_value()));
+}
+
+void Invariant_hoister::visit(Assignment_expr &node) {
+    node.set_value(hoist(node.get_value()));
+}
+
+void Invariant_hoister::visit(If_stmt &node) {
+    node.set_condition(hoist(node.get_condition()));
+    node.then_branch().accept(*this);
+    if (node.contains_else_branch())
+        node.else_branch().accept(*this);
+}
+
+void Invariant_hoister::visit(While_stmt &node) {
+    node.set_condition(hoist(node.get_condition()));
+    node.get_body().accept(*this);
+}
+
+void Invariant_hoister::visit(Print_stmt &node) {
+    node.set_value(hoist(node.get_value()));
+}
+
+void Invariant_hoister::visit(Return_stmt &node) {
+    node.set_value(hoist(node.get_value()));
+}
+
+void Invariant_hoister::visit(Binary_operator &node) {
+    node.set_left(hoist(node.get_left()));
+    node.set_right(hoist(node.get_right()));
+}
+
+void Invariant_hoister::visit(Unary_operator &node) {
+    node.set_operand(hoist(node.get_operand()));
+}
+
+void Invariant_hoister::visit(Call &node) {
+    node.set_target(hoist(node.get_target()));
+    for (auto &arg : node.get_args())
+        arg = hoist(*arg);
+}
+
+void Invariant_hoister::visit(Input &node) {}
+void Invariant_hoister::visit(Number &node) {}
+void Invariant_hoister::visit(Variable &node) {}
+void Invariant_hoister::visit(Func &node) {}
+
+Expression_ptr Invariant_hoister::hoist(Expression &expression) {
+    if (!is_computation(expression) || !is_invariant(expression)) {
+        expression.accept(*this);
+        return &expression;
+    }
+
+    // Pure expressions cannot trap, so evaluating them once before the loop
+    // is safe even if the loop body never runs.
+    const auto symbol = program_.get_symbols().intern(temporary_name);
+    const auto slot = program_.add_slot();
+    preheader_.push_back(pool_.make<Assignment_stmt>(
+        pool_.make<Variable>(symbol, slot), &expression));
+    return pool_.make<Variable>(symbol, slot);
+}
+
+bool Invariant_hoister::is_invariant(Expression &expression) const {
+    if (!is_pure(expression))
+        return false;
+
+    Invariance_checker checker{written_};
+    expression.accept(checker);
+    return checker.is_invariant();
+}
+
+std::size_t Loop_invariant_mover::run(Program &program) {
+    program_ = &program;
+    hoisted_ = 0;
+
+    program.accept(*this);
+    return hoisted_;
+}
+
+void Loop_invariant_mover::visit(Program &node) {
+    for (auto &stmt : node.get_stmts())
+        stmt = move(*stmt);
+}
+
+void Loop_invariant_mover::visit(Block_stmt &node) {
+    for (auto &stmt : node.get_stmts())
+        stmt = move(*stmt);
+    result_ = &node;
+}
+
+void Loop_invariant_mover::visit(If_stmt &node) {
+    node.set_then_branch(move(node.then_branch()));
+    if (node.contains_else_branch())
+        node.set_else_branch(move(node.else_branch()));
+    result_ = &node;
+}
+
+void Loop_invariant_mover::visit(While_stmt &node) {
+    StmtList preheader;
+
+    Slot_usage_collector usage{program_->get_slot_count()};
+    node.accept(usage);
+    if (!usage.has_calls()) {
+        Invariant_hoister hoister{pool_, *program_, usage.get_written()};
+        node.accept(hoister);
+        preheader = std::move(hoister.get_preheader());
+    }
+
+    node.set_body(move(node.get_body()));
+    result_ = &node;
+
+    if (preheader.empty())
+        return;
+
+    hoisted_ += preheader.size();
+    preheader.push_back(&node);
+    result_ = pool_.make<Block_stmt>(std::move(preheader));
+}
+
+void Loop_invariant_mover::visit(Empty_stmt &node) { result_ = &node; }
+void Loop_invariant_mover::visit(Assignment_stmt &node) { result_ = &node; }
+void Loop_invariant_mover::visit(Print_stmt &node) { result_ = &node; }
+void Loop_invariant_mover::visit(Return_stmt &node) { result_ = &node; }
+
+// Only statements are walked here, expressions belong to Invariant_hoister.
+void Loop_invariant_mover::visit(Input &node) {}
+void Loop_invariant_mover::visit(Assignment_expr &node) {}
+void Loop_invariant_mover::visit(Binary_operator &node) {}
+void Loop_invariant_mover::visit(Unary_operator &node) {}
+void Loop_invariant_mover::visit(Number &node) {}
+void Loop_invariant_mover::visit(Variable &node) {}
+void Loop_invariant_mover::visit(Func &node) {}
+void Loop_invariant_mover::visit(Call &node) {}
+
+Statement_ptr Loop_invariant_mover::move(Statement &stmt) {
+    stmt.accept(*this);
+    return result_;
+}
+
+} // namespace language
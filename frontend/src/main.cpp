@@ -4,11 +4,6 @@
 #include "parser.hpp"
 #include <iostream>
 
-extern int yylex();
-yy::parser::semantic_type *yylval = nullptr;
-
-int yyFlexLexer::yywrap() { return 1; }
-
 int main(int argc, const char *argv[]) {
     try {
         driver(argc, argv);
@@ -0,0 +1,46 @@
+#include "memo_table.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+
+namespace language {
+
+Memo_table::Memo_table(std::size_t size, Memo_eviction eviction)
+    : sets_(std::bit_ceil(std::max(size, ways)) / ways),
+      set_mask_(sets_.size() - 1), eviction_(eviction) {}
+
+Memo_table::Set &Memo_table::set_of(const Key &key) noexcept {
+    std::uint64_t hash = static_cast<std::uint32_t>(key.func);
+    for (const auto arg : key.args)
+        hash = (hash ^ static_cast<std::uint32_t>(arg)) * 0x9e3779b97f4a7c15;
+    return sets_[(hash >> 32) & set_mask_];
+}
+
+std::optional<number_t> Memo_table::find(const Key &key) noexcept {
+    auto &entries = set_of(key).entries;
+    for (std::size_t i = 0; i < ways; ++i) {
+        const auto &entry = entries[i];
+        if (entry.func != key.func || entry.args != key.args)
+            continue;
+
+        ++stats_.hits;
+        const auto value = entry.value;
+        if (eviction_ == Memo_eviction::Lru)
+            std::rotate(entries.begin(), entries.begin() + i,
+                        entries.begin() + i + 1);
+        return value;
+    }
+
+    ++stats_.misses;
+    return std::nullopt;
+}
+
+void Memo_table::insert(const Key &key, number_t value) noexcept {
+    auto &entries = set_of(key).entries;
+    if (entries.back().func != 0)
+        ++stats_.evictions;
+    std::copy_backward(entries.begin(), entries.end() - 1, entries.end());
+    entries.front() = {key.func, key.args, value};
+}
+
+} // namespace language
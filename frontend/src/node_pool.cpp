@@ -0,0 +1,82 @@
+#include "node_pool.hpp"
+#include <algorithm>
+#include <ranges>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace language {
+
+namespace {
+
+constexpr std::size_t huge_page_size = std::size_t{2} << 20;
+
+std::size_t round_up(std::size_t size, std::size_t granularity) {
+    return (size + granularity - 1) / granularity * granularity;
+}
+
+} // namespace
+
+void Node_pool::release() noexcept {
+    for (auto *node : nodes_ | std::views::reverse)
+        node->~Node();
+    nodes_.clear();
+
+    for (const auto &chunk : chunks_)
+        free_chunk(chunk);
+    chunks_.clear();
+
+    cursor_ = limit_ = nullptr;
+    bytes_used_ = 0;
+}
+
+std::size_t Node_pool::bytes_reserved() const noexcept {
+    std::size_t reserved = 0;
+    for (const auto &chunk : chunks_)
+        reserved += chunk.size;
+    return reserved;
+}
+
+std::byte *Node_pool::grow(std::size_t min_size) {
+    const auto chunk = allocate_chunk(std::max(min_size, chunk_size_));
+    chunks_.push_back(chunk);
+
+    cursor_ = chunk.data;
+    limit_ = chunk.data + chunk.size;
+    return cursor_;
+}
+
+Node_pool::Chunk Node_pool::allocate_chunk(std::size_t size) {
+#ifdef __linux__
+    if (use_huge_pages_) {
+        size = round_up(size, huge_page_size);
+
+        void *memory =
+            mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (memory == MAP_FAILED) {
+            // No reserved huge pages, ask for transparent ones instead.
+            memory = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (memory == MAP_FAILED)
+                throw std::bad_alloc();
+            madvise(memory, size, MADV_HUGEPAGE);
+        }
+        return Chunk{static_cast<std::byte *>(memory), size, true};
+    }
+#endif
+    return Chunk{static_cast<std::byte *>(::operator new(size)), size, false};
+}
+
+void Node_pool::free_chunk(const Chunk &chunk) noexcept {
+#ifdef __linux__
+    if (chunk.mapped) {
+        munmap(chunk.data, chunk.size);
+        return;
+    }
+#endif
+    ::operator delete(chunk.data);
+}
+
+} // namespace language
@@ -0,0 +1,34 @@
+#include "optimizer.hpp"
+#include "constant_folder.hpp"
+#include "dead_code_eliminator.hpp"
+#include "loop_invariant_mover.hpp"
+
+namespace language {
+
+Optimization_stats optimize(Program &program, Node_pool &pool) {
+    Optimization_stats stats;
+
+    // The passes know only global slots, function locals would alias them.
+    if (!program.get_functions().empty())
+        return stats;
+
+    Constant_folder folder{pool};
+    Dead_code_eliminator eliminator{pool};
+
+    // Dropping a branch can make more constants known after the join, so
+    // fold again until elimination stops making progress.
+    std::size_t removed = 0;
+    do {
+        folder.run(program);
+        stats.folded_nodes += folder.folded_count();
+
+        removed = eliminator.run(program);
+        stats.removed_nodes += removed;
+    } while (removed != 0);
+
+    stats.hoisted_expressions = Loop_invariant_mover{pool}.run(program);
+
+    return stats;
+}
+
+} // namespace language
@@ -0,0 +1,155 @@
+#include "options.hpp"
+#include <charconv>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace language {
+
+namespace {
+
+std::string usage(const char *program_name) {
+    return std::string("Usage: ") + program_name +
+           " [--engine=simulator|vm|flat|closure|jit] [--huge-pages]"
+           " [--arena-stats] [-O] [--opt-stats] [--flush=exit|line|size]"
+           " [--flush-size=<bytes>] [--input <file>] [--lex-only]"
+           " [--cache-dir=<dir>] [--cache-stats] [--max-call-depth=<calls>]"
+           " [--memo-size=<entries>] [--memo-eviction=lru|fifo] [--memo-stats]"
+           " [--profile] [--dump-heat=count|time] [--dump-prune]"
+           " <program_file>\n"
+           "       " +
+           program_name + " --check [--jobs=<threads>] <program_file>...";
+}
+
+Engine parse_engine(std::string_view name) {
+    if (name == "simulator")
+        return Engine::Simulator;
+    if (name == "vm")
+        return Engine::Vm;
+    if (name == "flat")
+        return Engine::Flat;
+    if (name == "closure")
+        return Engine::Closure;
+    if (name == "jit")
+        return Engine::Jit;
+
+    throw std::runtime_error("unknown engine: " + std::string(name));
+}
+
+Flush_policy parse_flush_policy(std::string_view name) {
+    if (name == "exit")
+        return Flush_policy::Exit;
+    if (name == "line")
+        return Flush_policy::Line;
+    if (name == "size")
+        return Flush_policy::Size;
+
+    throw std::runtime_error("unknown flush policy: " + std::string(name));
+}
+
+Memo_eviction parse_memo_eviction(std::string_view name) {
+    if (name == "lru")
+        return Memo_eviction::Lru;
+    if (name == "fifo")
+        return Memo_eviction::Fifo;
+
+    throw std::runtime_error("unknown memo eviction policy: " +
+                             std::string(name));
+}
+
+Heat_mode parse_heat_mode(std::string_view name) {
+    if (name == "count")
+        return Heat_mode::Count;
+    if (name == "time")
+        return Heat_mode::Time;
+
+    throw std::runtime_error("unknown heat mode: " + std::string(name));
+}
+
+std::size_t parse_size(std::string_view value, bool allow_zero = false) {
+    std::size_t size = 0;
+    const auto [end, error] =
+        std::from_chars(value.data(), value.data() + value.size(), size);
+    if (error != std::errc{} || end != value.data() + value.size() ||
+        (size == 0 && !allow_zero))
+        throw std::runtime_error("invalid size: " + std::string(value));
+    return size;
+}
+
+} // namespace
+
+Options parse_options(int argc, const char **argv) {
+    Options options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+
+        if (arg.starts_with("--engine=")) {
+            options.engine = parse_engine(arg.substr(arg.find('=') + 1));
+        } else if (arg == "--huge-pages") {
+            options.use_huge_pages = true;
+        } else if (arg == "--arena-stats") {
+            options.arena_stats = true;
+        } else if (arg == "-O") {
+            options.optimize = true;
+        } else if (arg == "--opt-stats") {
+            options.optimizer_stats = true;
+        } else if (arg.starts_with("--flush=")) {
+            options.flush_policy =
+                parse_flush_policy(arg.substr(arg.find('=') + 1));
+        } else if (arg.starts_with("--flush-size=")) {
+            options.flush_size = parse_size(arg.substr(arg.find('=') + 1));
+        } else if (arg.starts_with("--max-call-depth=")) {
+            options.max_call_depth = parse_size(arg.substr(arg.find('=') + 1));
+            if (options.max_call_depth > Simulator::max_call_depth)
+                throw std::runtime_error(
+                    "--max-call-depth is at most " +
+                    std::to_string(Simulator::max_call_depth));
+        } else if (arg.starts_with("--memo-size=")) {
+            options.memo_size =
+                parse_size(arg.substr(arg.find('=') + 1), true);
+        } else if (arg.starts_with("--memo-eviction=")) {
+            options.memo_eviction =
+                parse_memo_eviction(arg.substr(arg.find('=') + 1));
+        } else if (arg == "--memo-stats") {
+            options.memo_stats = true;
+        } else if (arg == "--profile") {
+            options.profile = true;
+        } else if (arg.starts_with("--dump-heat=")) {
+            options.dump_heat = parse_heat_mode(arg.substr(arg.find('=') + 1));
+        } else if (arg == "--dump-prune") {
+            options.dump_prune = true;
+        } else if (arg == "--check") {
+            options.check = true;
+        } else if (arg.starts_with("--jobs=")) {
+            options.jobs = parse_size(arg.substr(arg.find('=') + 1));
+        } else if (arg.starts_with("--cache-dir=")) {
+            options.cache_dir = arg.substr(arg.find('=') + 1);
+            if (options.cache_dir.empty())
+                throw std::runtime_error("--cache-dir requires a directory\n" +
+                                         usage(argv[0]));
+        } else if (arg == "--cache-stats") {
+            options.cache_stats = true;
+        } else if (arg == "--lex-only") {
+            options.lex_only = true;
+        } else if (arg == "--input") {
+            if (++i == argc)
+                throw std::runtime_error("--input requires a file name\n" +
+                                         usage(argv[0]));
+            options.input_file = argv[i];
+        } else if (arg.starts_with("-") && arg.size() > 1) {
+            throw std::runtime_error("unknown option: " + std::string(arg) +
+                                     '\n' + usage(argv[0]));
+        } else {
+            options.program_files.emplace_back(arg);
+        }
+    }
+
+    if (options.program_files.empty() ||
+        (!options.check && options.program_files.size() > 1))
+        throw std::runtime_error(usage(argv[0]));
+
+    return options;
+}
+
+} // namespace language
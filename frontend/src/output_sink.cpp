@@ -0,0 +1,142 @@
+#include "output_sink.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <csignal>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace language {
+
+namespace {
+
+// Longest decimal number_t plus the sign and the newline.
+constexpr std::size_t max_line_size =
+    std::numeric_limits<number_t>::digits10 + 3;
+
+#ifdef IOV_MAX
+constexpr int max_iov = IOV_MAX;
+#else
+constexpr int max_iov = 1024;
+#endif
+
+volatile std::sig_atomic_t handler_installed = 0;
+Output_sink *volatile active_sink = nullptr;
+
+extern "C" void flush_on_trap(int signal) {
+    if (Output_sink *sink = active_sink)
+        sink->write_buffered();
+
+    // The handler was reset by SA_RESETHAND, so re-raising terminates the
+    // process with the original signal and exit status.
+    std::raise(signal);
+}
+
+void install_trap_handler() {
+    if (handler_installed)
+        return;
+
+    struct sigaction action {};
+    action.sa_handler = flush_on_trap;
+    action.sa_flags = SA_RESETHAND | SA_NODEFER;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGFPE, &action, nullptr);
+
+    handler_installed = 1;
+}
+
+} // namespace
+
+Output_sink::Output_sink(int fd, Flush_policy policy, std::size_t threshold)
+    : fd_(fd), policy_(policy),
+      threshold_(std::max<std::size_t>(threshold, 1)) {
+    blocks_.push_back({std::make_unique<char[]>(block_size), 0});
+
+    install_trap_handler();
+    previous_ = active_sink;
+    active_sink = this;
+}
+
+Output_sink::~Output_sink() {
+    active_sink = previous_;
+    write_buffered();
+}
+
+Flush_policy Output_sink::default_policy(int fd) noexcept {
+    return isatty(fd) ? Flush_policy::Line : Flush_policy::Size;
+}
+
+void Output_sink::flush() {
+    if (!write_buffered())
+        throw std::runtime_error(std::string("unable to write output: ") +
+                                 std::strerror(errno));
+}
+
+bool Output_sink::write_buffered() noexcept {
+    if (buffered_ == 0)
+        return true;
+
+    iovec iov[max_iov];
+    std::size_t block = 0;
+    std::size_t offset = 0; // already written part of blocks_[block]
+
+    while (block <= current_) {
+        if (offset == blocks_[block].size) {
+            ++block;
+            offset = 0;
+            continue;
+        }
+
+        int count = 0;
+        for (std::size_t i = block; i <= current_ && count < max_iov; ++i) {
+            const std::size_t skip = i == block ? offset : 0;
+            iov[count].iov_base = blocks_[i].data.get() + skip;
+            iov[count].iov_len = blocks_[i].size - skip;
+            ++count;
+        }
+
+        const ssize_t written = writev(fd_, iov, count);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+
+        // writev may stop in the middle of any block.
+        for (auto left = static_cast<std::size_t>(written); left != 0;) {
+            const std::size_t rest = blocks_[block].size - offset;
+            if (left < rest) {
+                offset += left;
+                break;
+            }
+            left -= rest;
+            ++block;
+            offset = 0;
+        }
+    }
+
+    for (std::size_t i = 0; i <= current_; ++i)
+        blocks_[i].size = 0;
+    current_ = 0;
+    buffered_ = 0;
+    return true;
+}
+
+void Output_sink::reserve_line() {
+    if (block_size - blocks_[current_].size >= max_line_size)
+        return;
+
+    if (++current_ == blocks_.size())
+        blocks_.push_back({std::make_unique<char[]>(block_size), 0});
+}
+
+char *Output_sink::format(char *out, number_t value) noexcept {
+    return std::to_chars(out, out + max_line_size, value).ptr;
+}
+
+} // namespace language
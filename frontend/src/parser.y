@@ -9,12 +9,15 @@
 %nonassoc TOK_ELSE
 
 %lex-param   { language::Lexer *scanner }
+%lex-param   { language::My_parser *my_parser }
 %parse-param { language::Lexer *scanner }
 %parse-param { language::Node_pool &pool }
 %parse-param { language::program_ptr &root }
 %parse-param { language::My_parser *my_parser }
 
 %code requires {
+  #include <algorithm>
+  #include <optional>
   #include <string>
   #include <string_view>
   #include <type_traits>
@@ -32,21 +35,20 @@
   using language::Node_pool;
   using language::Binary_operators;
   using language::Unary_operators;
-  using language::nametable_t;
   using language::name_t;
   using language::name_t_sv;
 
   template<typename T>
-  void push_scope(T* parser, nametable_t&& nametable);
+  void push_scope(T* parser);
 
   template<typename T>
   void pop_scope(T* parser);
 
   template<typename T>
-  name_t_sv lookup_in_scopes(T* parser, name_t_sv var_name);
+  std::optional<language::Slot_ref> lookup_in_scopes(T* parser, language::symbol_id_t var);
 
   template<typename T>
-  name_t_sv add_var_to_scope(T* parser, name_t_sv var_name);
+  language::Slot_ref add_var_to_scope(T* parser, language::symbol_id_t var);
 }
 
 %code {
@@ -54,12 +56,14 @@
   #include "lexer.hpp"
   #include "error_collector.hpp"
   #include "my_parser.hpp"
+  #include <charconv>
   #include <iostream>
+  #include <optional>
   #include <string>
 
   template<typename T>
-  void push_scope(T* parser, nametable_t&& nametable) {
-    parser->scopes.push(std::move(nametable));
+  void push_scope(T* parser) {
+    parser->scopes.push();
   }
 
   template<typename T>
@@ -68,38 +72,56 @@
   }
 
   template<typename T>
-  name_t_sv lookup_in_scopes(T* parser, name_t_sv var_name) {
-    return parser->scopes.lookup(var_name);
+  std::optional<language::Slot_ref> lookup_in_scopes(T* parser, language::symbol_id_t var) {
+    return parser->scopes.lookup(var);
   }
 
   template<typename T>
-  name_t_sv add_var_to_scope(T* parser, name_t_sv var_name) {
-    return parser->scopes.add_variable(var_name);
+  language::Slot_ref add_var_to_scope(T* parser, language::symbol_id_t var) {
+    return parser->scopes.add_variable(var);
+  }
+
+  language::Statement_ptr located(const yy::location &loc, language::Statement_ptr stmt) {
+    // Null after error recovery.
+    if (stmt)
+      stmt->set_position(loc.begin.line, loc.begin.column);
+    return stmt;
+  }
+
+  std::optional<language::number_t> parse_number(std::string_view text) {
+    language::number_t value = 0;
+    const auto [end, error] =
+        std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc{} || end != text.data() + text.size())
+      return std::nullopt;
+    return value;
   }
 
   int yylex(yy::parser::semantic_type* yylval,
             yy::parser::location_type* yylloc,
-            language::Lexer*           scanner) {
-    int line_before = scanner->get_line();
-
+            language::Lexer*           scanner,
+            language::My_parser*       my_parser) {
     auto tt = scanner->yylex();
 
-    yylloc->begin.line = line_before;
+    // Tokens never span lines.
+    yylloc->begin.line = scanner->get_line();
     yylloc->begin.column = scanner->get_column() - scanner->get_yyleng();
     yylloc->end.line = scanner->get_line();
     yylloc->end.column = scanner->get_column();
 
+    // Points into the program source, which outlives the AST.
     if (tt == yy::parser::token::TOK_NUMBER)
-        yylval->build<int>() = std::stoi(scanner->YYText());
+        yylval->build<name_t_sv>() = scanner->get_text();
 
     if (tt == yy::parser::token::TOK_ID)
-        yylval->build<std::string>() = scanner->YYText();
+        yylval->build<language::symbol_id_t>() =
+            my_parser->symbols.intern(scanner->get_text());
 
     return tt;
   }
 
   void yy::parser::error(const location& loc, const std::string& msg) {
-    my_parser->error_collector.add_error(loc, msg, my_parser->get_line_content(loc.begin.line));
+    my_parser->error_collector.add_error(loc, msg);
   }
 }
 
@@ -110,6 +132,8 @@
 %token TOK_WHILE         "while"
 %token TOK_PRINT         "print"
 %token TOK_INPUT         "?"
+%token TOK_FUNC          "func"
+%token TOK_RETURN        "return"
 
 /* --- Arithmetic operators --- */
 %token TOK_PLUS          "+"
@@ -143,10 +167,12 @@
 %token TOK_LEFT_BRACE    "{"
 %token TOK_RIGHT_BRACE   "}"
 %token TOK_SEMICOLON     ";"
+%token TOK_COMMA         ","
+%token TOK_COLON         ":"
 
 /* --- Tokens with semantic values --- */
-%token <std::string> TOK_ID     "identifier"
-%token <int>         TOK_NUMBER "number"
+%token <language::symbol_id_t> TOK_ID     "identifier"
+%token <name_t_sv>             TOK_NUMBER "number"
 
 /* --- End of file --- */
 %token TOK_EOF 0
@@ -156,8 +182,11 @@
 %type <language::Statement_ptr>        toplevel_statement
 %type <language::StmtList>             stmt_list
 %type <language::Statement_ptr>        statement
-%type <language::Statement_ptr>        assignment_stmt if_stmt while_stmt print_stmt block_stmt empty_stmt
-%type <language::Expression_ptr>       expression bitwise_op equality relational add_sub mul_div unary primary assignment_expr or and
+%type <language::Statement_ptr>        assignment_stmt if_stmt while_stmt print_stmt return_stmt block_stmt empty_stmt
+%type <language::Expression_ptr>       expression bitwise_op equality relational add_sub mul_div unary postfix primary assignment_expr or and func_expr
+%type <language::Func::ParamList>      param_list params
+%type <language::Call::ArgExprList>    arg_list args
+%type <language::Variable_ptr>         func_name
 
 
 %start program
@@ -166,7 +195,8 @@
 
 program        : toplevel_stmt_list TOK_EOF
                 {
-                  root = pool.make<language::Program>($1);
+                  root = pool.make<language::Program>(std::move($1), my_parser->scopes.slot_count(),
+                                               my_parser->symbols, std::move(my_parser->functions));
                 }
                ;
 
@@ -177,7 +207,7 @@ toplevel_stmt_list:
                | toplevel_stmt_list toplevel_statement
                 {
                   $1.push_back($2);
-                  $$ = $1;
+                  $$ = std::move($1);
                 }
                ;
 
@@ -198,22 +228,24 @@ stmt_list:
                | stmt_list statement
                 {
                   $1.push_back($2);
-                  $$ = $1;
+                  $$ = std::move($1);
                 }
                ;
 
 statement      : assignment_stmt TOK_SEMICOLON
-                 { $$ = $1; }
+                 { $$ = located(@1, $1); }
                | if_stmt
-                 { $$ = $1; }
+                 { $$ = located(@1, $1); }
                | while_stmt
-                 { $$ = $1; }
+                 { $$ = located(@1, $1); }
                | print_stmt TOK_SEMICOLON
-                 { $$ = $1; }
+                 { $$ = located(@1, $1); }
+               | return_stmt TOK_SEMICOLON
+                 { $$ = located(@1, $1); }
                | block_stmt
-                 { $$ = $1; }
+                 { $$ = located(@1, $1); }
                | empty_stmt
-                 { $$ = $1; }
+                 { $$ = located(@1, $1); }
                | error TOK_SEMICOLON
                  {
                    yyerrok;
@@ -228,23 +260,21 @@ empty_stmt     : TOK_SEMICOLON
 
 block_stmt     : TOK_LEFT_BRACE
                 {
-                  push_scope(my_parser, nametable_t{});
+                  push_scope(my_parser);
                 }
                 stmt_list
                 TOK_RIGHT_BRACE
                 {
                   pop_scope(my_parser);
-                  $$ = pool.make<language::Block_stmt>($3);
+                  $$ = pool.make<language::Block_stmt>(std::move($3));
                 }
                ;
 
 assignment_stmt: TOK_ID TOK_ASSIGN expression
                 {
-                  language::name_t_sv name_sv = lookup_in_scopes(my_parser, $1);
-                  if (name_sv.empty())
-                    name_sv = add_var_to_scope(my_parser, $1);
+                  const auto slot = add_var_to_scope(my_parser, $1);
 
-                  auto variable = pool.make<language::Variable>(name_sv);
+                  auto variable = pool.make<language::Variable>($1, slot.slot, slot.local);
                   $$ = pool.make<language::Assignment_stmt>(variable, $3);
                 }
                 ;
@@ -287,6 +317,15 @@ print_stmt     : TOK_PRINT expression
                 }
                ;
 
+return_stmt    : TOK_RETURN expression
+                {
+                  if (!my_parser->scopes.in_function())
+                    error(@1, "'return' outside of a function");
+
+                  $$ = pool.make<language::Return_stmt>($2);
+                }
+               ;
+
 expression     : assignment_expr
                 {
                   $$ = $1;
@@ -357,37 +396,108 @@ unary          : TOK_MINUS unary
                 { $$ = pool.make<language::Unary_operator>(Unary_operators::Plus, $2); }
                | TOK_NOT unary
                 { $$ = pool.make<language::Unary_operator>(Unary_operators::Not, $2); }
-               | primary
+               | postfix
                 { $$ = $1; }
                ;
 
+postfix        : primary
+                { $$ = $1; }
+               | postfix TOK_LEFT_PAREN arg_list TOK_RIGHT_PAREN
+                { $$ = pool.make<language::Call>($1, std::move($3)); }
+               ;
+
+arg_list       :
+                { $$ = language::Call::ArgExprList{}; }
+               | args
+                { $$ = std::move($1); }
+               ;
+
+args           : expression
+                { $$ = language::Call::ArgExprList{$1}; }
+               | args TOK_COMMA expression
+                {
+                  $1.push_back($3);
+                  $$ = std::move($1);
+                }
+               ;
+
 primary        : TOK_NUMBER
-                { $$ = pool.make<language::Number>($1); }
+                {
+                  auto value = parse_number($1);
+                  if (!value)
+                    error(@1, "integer literal '" + std::string($1) + "' is out of range");
+
+                  $$ = pool.make<language::Number>(value.value_or(0));
+                }
                | TOK_ID
                 {
-                  language::name_t_sv name_sv = lookup_in_scopes(my_parser, $1);
-                  if (name_sv.empty()) {
-                    error(@1, std::string("'") + $1 + "' was not declared in this scope");
-                    name_sv = add_var_to_scope(my_parser, $1);
+                  auto slot = lookup_in_scopes(my_parser, $1);
+                  if (!slot) {
+                    error(@1, "'" + std::string(my_parser->symbols.name($1)) + "' was not declared in this scope");
+                    slot = add_var_to_scope(my_parser, $1);
                   }
 
-                  $$ = pool.make<language::Variable>(name_sv);
+                  $$ = pool.make<language::Variable>($1, slot->slot, slot->local);
                 }
                | TOK_LEFT_PAREN expression TOK_RIGHT_PAREN
                 { $$ = $2; }
                | TOK_INPUT
                 { $$ = pool.make<language::Input>(); }
+               | func_expr
+                { $$ = $1; }
+               ;
+
+func_expr      : TOK_FUNC TOK_LEFT_PAREN param_list TOK_RIGHT_PAREN func_name
+                {
+                  my_parser->scopes.push_function();
+                  for (const auto param : $3)
+                    my_parser->scopes.add_parameter(param);
+                }
+                block_stmt
+                {
+                  const auto frame_size = my_parser->scopes.pop_function();
+                  const auto id = static_cast<language::number_t>(my_parser->functions.size() + 1);
+
+                  auto func = pool.make<language::Func>(id, $5, std::move($3), $7, frame_size);
+                  my_parser->functions.push_back(func);
+                  $$ = func;
+                }
+               ;
+
+param_list     :
+                { $$ = language::Func::ParamList{}; }
+               | params
+                { $$ = std::move($1); }
+               ;
+
+params         : TOK_ID
+                { $$ = language::Func::ParamList{$1}; }
+               | params TOK_COMMA TOK_ID
+                {
+                  if (std::find($1.begin(), $1.end(), $3) != $1.end())
+                    error(@3, "duplicate parameter '" + std::string(my_parser->symbols.name($3)) + "'");
+                  $1.push_back($3);
+                  $$ = std::move($1);
+                }
+               ;
+
+/* The name is declared before the body, so that the function can call itself. */
+func_name      :
+                { $$ = nullptr; }
+               | TOK_COLON TOK_ID
+                {
+                  const auto slot = add_var_to_scope(my_parser, $2);
+                  $$ = pool.make<language::Variable>($2, slot.slot, slot.local);
+                }
                ;
 
 assignment_expr
               : or { $$ = $1; }
               | TOK_ID TOK_ASSIGN assignment_expr
                 {
-                  language::name_t_sv name_sv = lookup_in_scopes(my_parser, $1);
-                  if (name_sv.empty())
-                    name_sv = add_var_to_scope(my_parser, $1);
+                  const auto slot = add_var_to_scope(my_parser, $1);
 
-                  auto variable = pool.make<language::Variable>(name_sv);
+                  auto variable = pool.make<language::Variable>($1, slot.slot, slot.local);
                   $$ = pool.make<language::Assignment_expr>(variable, $3);
                 }
               ;
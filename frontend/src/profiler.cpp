@@ -0,0 +1,228 @@
+#include "profiler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <ctime>
+#include <iomanip>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace language {
+
+namespace {
+
+Profiler *sampled_profiler = nullptr;
+
+std::string location_of(const Statement &stmt) {
+    if (stmt.get_line() == 0)
+        return "-";
+    return std::to_string(stmt.get_line()) + ':' +
+           std::to_string(stmt.get_column());
+}
+
+} // namespace
+
+// Delivers SIGPROF to the profiler every sample period while it is alive.
+class Sampling_timer final {
+  private:
+    timer_t timer_{};
+    struct sigaction previous_{};
+
+  public:
+    explicit Sampling_timer(Profiler &profiler) {
+        sampled_profiler = &profiler;
+
+        struct sigaction action{};
+        action.sa_handler = [](int) { sampled_profiler->sample(); };
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        sigaction(SIGPROF, &action, &previous_);
+
+        sigevent event{};
+        event.sigev_notify = SIGEV_SIGNAL;
+        event.sigev_signo = SIGPROF;
+        if (timer_create(CLOCK_MONOTONIC, &event, &timer_) != 0) {
+            sigaction(SIGPROF, &previous_, nullptr);
+            throw std::runtime_error("unable to create the profiling timer");
+        }
+
+        const auto period =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                Profiler::sample_period)
+                .count();
+        itimerspec spec{};
+        spec.it_interval.tv_nsec = period;
+        spec.it_value.tv_nsec = period;
+        timer_settime(timer_, 0, &spec, nullptr);
+    }
+
+    Sampling_timer(const Sampling_timer &) = delete;
+    Sampling_timer &operator=(const Sampling_timer &) = delete;
+
+    ~Sampling_timer() {
+        timer_delete(timer_);
+        sigaction(SIGPROF, &previous_, nullptr);
+        sampled_profiler = nullptr;
+    }
+};
+
+void Profiler::sample() noexcept {
+    const auto sample = samples_ + 1;
+    samples_ = sample;
+
+    Active *active = innermost_;
+    if (!active)
+        return;
+    ++active->entry->self_samples;
+    for (; active; active = active->outer) {
+        auto *entry = active->entry;
+        if (entry->last_sample != sample) {
+            entry->last_sample = sample;
+            ++entry->total_samples;
+        }
+    }
+}
+
+template <typename Stmt> void Profiler::measure(Stmt &node, const char *kind) {
+    measure(node, kind, [&] { Simulator::visit(node); });
+}
+
+template <typename Stmt, typename Run>
+void Profiler::measure(Stmt &node, const char *kind, Run &&run) {
+    auto &entry = entries_[&node];
+    entry.kind = kind;
+    ++entry.count;
+
+    Active active{&entry, innermost_};
+    // The handler must not see the link before the entry is in it.
+    std::atomic_signal_fence(std::memory_order_release);
+    innermost_ = &active;
+
+    // Unlinks the statement however it ends, so that the handler never
+    // follows a link into a frame that is gone.
+    struct Unlink final {
+        Profiler &profiler;
+        Active &active;
+        ~Unlink() { profiler.innermost_ = active.outer; }
+    } unlink{*this, active};
+    run();
+}
+
+void Profiler::visit(Program &node) {
+    const auto start = clock::now();
+    {
+        Sampling_timer timer{*this};
+        Simulator::visit(node);
+    }
+    elapsed_ = clock::now() - start;
+}
+
+void Profiler::visit(Empty_stmt &node) { measure(node, "empty"); }
+void Profiler::visit(Assignment_stmt &node) { measure(node, "assignment"); }
+void Profiler::visit(If_stmt &node) {
+    ++conditions_[&node.get_condition()];
+    measure(node, "if");
+}
+
+// The loop of Simulator::visit(While_stmt &), counting the evaluations of
+// the condition.
+void Profiler::visit(While_stmt &node) {
+    measure(node, "while", [&] {
+        auto &evaluations = conditions_[&node.get_condition()];
+        while ((++evaluations, evaluate_expression(node.get_condition()))) {
+            node.get_body().accept(*this);
+            if (returning())
+                return;
+        }
+    });
+}
+
+void Profiler::visit(Print_stmt &node) { measure(node, "print"); }
+void Profiler::visit(Return_stmt &node) { measure(node, "return"); }
+
+void Profiler::report(std::ostream &os, const Source_file &source) const {
+    std::vector<std::pair<const Statement *, const Entry *>> hot;
+    std::uint64_t executed = 0;
+    for (const auto &[stmt, entry] : entries_) {
+        hot.emplace_back(stmt, &entry);
+        executed += entry.count;
+    }
+    std::sort(hot.begin(), hot.end(), [](const auto &a, const auto &b) {
+        if (a.second->self_samples != b.second->self_samples)
+            return a.second->self_samples > b.second->self_samples;
+        if (a.second->count != b.second->count)
+            return a.second->count > b.second->count;
+        if (a.first->get_line() != b.first->get_line())
+            return a.first->get_line() < b.first->get_line();
+        return a.first->get_column() < b.first->get_column();
+    });
+
+    const std::uint64_t samples = samples_;
+    const double elapsed_ms =
+        std::chrono::duration<double, std::milli>(elapsed_).count();
+    const auto milliseconds = [&](std::uint64_t share) {
+        return samples ? elapsed_ms * share / samples : 0.0;
+    };
+
+    const auto flags = os.flags();
+    const auto precision = os.precision();
+    os << std::fixed << std::setprecision(1);
+
+    os << "profile: " << executed << " statements run in " << elapsed_ms
+       << " ms, " << samples << " samples\n";
+    os << std::setw(12) << "count" << std::setw(12) << "self ms"
+       << std::setw(12) << "total ms" << std::setw(9) << "self %"
+       << "  location    statement\n";
+    const auto shown = std::min(hot.size(), hot_spot_limit);
+    for (std::size_t i = 0; i < shown; ++i) {
+        const auto &[stmt, entry] = hot[i];
+        const double share =
+            samples ? 100.0 * entry->self_samples / samples : 0.0;
+        os << std::setw(12) << entry->count << std::setw(12)
+           << milliseconds(entry->self_samples) << std::setw(12)
+           << milliseconds(entry->total_samples) << std::setw(8) << share
+           << "%  " << std::left << std::setw(12) << location_of(*stmt)
+           << entry->kind << std::right << '\n';
+    }
+    if (hot.size() > shown)
+        os << "  ... " << hot.size() - shown << " more statements\n";
+
+    // Several statements may start on one line: the line shows the most
+    // executed one and their combined self time.
+    struct Line final {
+        std::uint64_t count = 0;
+        std::uint64_t self_samples = 0;
+        bool executed = false;
+    };
+    const auto text = source.text();
+    const auto n_lines = static_cast<std::size_t>(
+        std::count(text.begin(), text.end(), '\n') +
+        (!text.empty() && text.back() != '\n'));
+    std::vector<Line> lines(n_lines + 1);
+    for (const auto &[stmt, entry] : entries_) {
+        if (stmt->get_line() == 0 || stmt->get_line() > n_lines)
+            continue;
+        auto &line = lines[stmt->get_line()];
+        line.count = std::max(line.count, entry.count);
+        line.self_samples += entry.self_samples;
+        line.executed = true;
+    }
+
+    os << '\n' << std::setw(12) << "count" << std::setw(12) << "self ms"
+       << "  source\n";
+    for (std::size_t number = 1; number <= n_lines; ++number) {
+        const auto &line = lines[number];
+        if (line.executed)
+            os << std::setw(12) << line.count << std::setw(12)
+               << milliseconds(line.self_samples);
+        else
+            os << std::setw(24) << "";
+        os << "  " << source.line(static_cast<int>(number)) << '\n';
+    }
+
+    os.flags(flags);
+    os.precision(precision);
+}
+
+} // namespace language
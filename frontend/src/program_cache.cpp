@@ -0,0 +1,256 @@
+#include "program_cache.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <type_traits>
+#include <unistd.h>
+#include <vector>
+
+#ifndef FRONTEND_VERSION
+#define FRONTEND_VERSION "unknown"
+#endif
+
+namespace language {
+
+namespace {
+
+constexpr char entry_magic[8] = {'F', 'L', 'A', 'T', 'A', 'S', 'T', '\0'};
+// Bumped whenever the header or the flat AST layout changes.
+constexpr std::uint32_t format_version = 1;
+constexpr std::string_view compiler_version = FRONTEND_VERSION;
+
+struct Header {
+    char magic[8];
+    std::uint32_t format_version;
+    std::uint32_t optimized;
+    char compiler_version[32];
+    std::uint64_t source_hash;
+    std::uint64_t source_size;
+    std::uint64_t payload_hash;
+    std::uint32_t node_count;
+    std::uint32_t children_count;
+    std::uint32_t slot_count;
+    std::uint32_t names_size;
+};
+static_assert(std::is_trivially_copyable_v<Header>);
+static_assert(sizeof(Header) % 8 == 0);
+
+// File offsets of the arrays, each one starts 8-byte aligned.
+struct Sections {
+    std::size_t kinds;
+    std::size_t ops;
+    std::size_t first;
+    std::size_t second;
+    std::size_t children;
+    std::size_t name_offsets;
+    std::size_t names;
+    std::size_t end;
+};
+
+Sections sections(const Header &header) {
+    std::size_t offset = sizeof(Header);
+    const auto place = [&offset](std::size_t bytes) {
+        const auto at = offset;
+        offset = (offset + bytes + 7) & ~std::size_t{7};
+        return at;
+    };
+
+    Sections result{};
+    result.kinds = place(header.node_count * sizeof(Node_kind));
+    result.ops = place(header.node_count * sizeof(std::uint8_t));
+    result.first = place(header.node_count * sizeof(std::uint32_t));
+    result.second = place(header.node_count * sizeof(std::uint32_t));
+    result.children = place(header.children_count * sizeof(node_id));
+    result.name_offsets =
+        place((std::size_t{header.slot_count} + 1) * sizeof(std::uint32_t));
+    result.names = place(header.names_size);
+    result.end = offset;
+    return result;
+}
+
+// Word-at-a-time multiplicative hash; good enough to tell sources apart and
+// to catch damaged entries, and fast enough to run on every load.
+std::uint64_t hash_bytes(const char *data, std::size_t size) noexcept {
+    constexpr std::uint64_t multiplier = 0x9e3779b97f4a7c15;
+
+    std::uint64_t hash = size * multiplier;
+    for (; size >= 8; data += 8, size -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data, 8);
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 29;
+    }
+    std::uint64_t tail = 0;
+    std::memcpy(&tail, data, size);
+    hash = (hash ^ tail) * multiplier;
+    return hash ^ (hash >> 32);
+}
+
+void copy_version(char (&target)[32]) {
+    std::memset(target, 0, sizeof(target));
+    const auto length = std::min(compiler_version.size(), sizeof(target) - 1);
+    std::memcpy(target, compiler_version.data(), length);
+}
+
+bool same_version(const char (&stored)[32]) {
+    char current[32];
+    copy_version(current);
+    return std::memcmp(stored, current, sizeof(current)) == 0;
+}
+
+class Mapping final {
+  private:
+    void *data_;
+    std::size_t size_;
+
+  public:
+    Mapping(void *data, std::size_t size) : data_(data), size_(size) {}
+    ~Mapping() { munmap(data_, size_); }
+
+    Mapping(const Mapping &) = delete;
+    Mapping &operator=(const Mapping &) = delete;
+
+    const char *data() const noexcept {
+        return static_cast<const char *>(data_);
+    }
+    std::size_t size() const noexcept { return size_; }
+};
+
+template <typename T>
+std::span<const T> view(const Mapping &mapping, std::size_t offset,
+                        std::size_t count) {
+    return {reinterpret_cast<const T *>(mapping.data() + offset), count};
+}
+
+} // namespace
+
+Program_cache::Program_cache(std::filesystem::path directory)
+    : directory_(std::move(directory)) {
+    std::filesystem::create_directories(directory_);
+}
+
+Cache_key Program_cache::key(std::string_view source,
+                             bool optimized) noexcept {
+    return {hash_bytes(source.data(), source.size()), source.size(),
+            optimized};
+}
+
+std::filesystem::path Program_cache::entry_path(const Cache_key &key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx%s.ast",
+                  static_cast<unsigned long long>(key.source_hash),
+                  key.optimized ? "-O" : "");
+    return directory_ / name;
+}
+
+Cache_lookup Program_cache::load(const Cache_key &key) const {
+    const auto path = entry_path(key);
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return {errno == ENOENT ? Cache_status::Miss : Cache_status::Corrupt,
+                std::nullopt};
+
+    struct stat info {};
+    void *data = MAP_FAILED;
+    std::size_t size = 0;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) &&
+        static_cast<std::size_t>(info.st_size) >= sizeof(Header)) {
+        size = static_cast<std::size_t>(info.st_size);
+        data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    if (data == MAP_FAILED)
+        return {Cache_status::Corrupt, std::nullopt};
+    auto mapping = std::make_shared<const Mapping>(data, size);
+
+    Header header;
+    std::memcpy(&header, mapping->data(), sizeof(header));
+    if (std::memcmp(header.magic, entry_magic, sizeof(entry_magic)) != 0)
+        return {Cache_status::Corrupt, std::nullopt};
+
+    if (header.format_version != format_version ||
+        !same_version(header.compiler_version) ||
+        header.source_hash != key.source_hash ||
+        header.source_size != key.source_size ||
+        header.optimized != key.optimized)
+        return {Cache_status::Stale, std::nullopt};
+
+    const auto offsets = sections(header);
+    if (offsets.end != size || header.node_count == 0 ||
+        hash_bytes(mapping->data() + sizeof(Header),
+                   size - sizeof(Header)) != header.payload_hash)
+        return {Cache_status::Corrupt, std::nullopt};
+
+    const Flat_ast::Layout layout{
+        view<Node_kind>(*mapping, offsets.kinds, header.node_count),
+        view<std::uint8_t>(*mapping, offsets.ops, header.node_count),
+        view<std::uint32_t>(*mapping, offsets.first, header.node_count),
+        view<std::uint32_t>(*mapping, offsets.second, header.node_count),
+        view<node_id>(*mapping, offsets.children, header.children_count),
+        view<std::uint32_t>(*mapping, offsets.name_offsets,
+                            std::size_t{header.slot_count} + 1),
+        {mapping->data() + offsets.names, header.names_size}};
+    if (layout.kinds.front() != Node_kind::Program ||
+        layout.name_offsets.back() != header.names_size)
+        return {Cache_status::Corrupt, std::nullopt};
+
+    return {Cache_status::Hit, Flat_ast{layout, std::move(mapping)}};
+}
+
+void Program_cache::store(const Cache_key &key,
+                          const Flat_ast &program) const {
+    const auto &layout = program.layout();
+
+    Header header{};
+    std::memcpy(header.magic, entry_magic, sizeof(entry_magic));
+    header.format_version = format_version;
+    header.optimized = key.optimized;
+    copy_version(header.compiler_version);
+    header.source_hash = key.source_hash;
+    header.source_size = key.source_size;
+    header.node_count = layout.kinds.size();
+    header.children_count = layout.children.size();
+    header.slot_count = program.slot_count();
+    header.names_size = layout.names.size();
+
+    const auto offsets = sections(header);
+    std::vector<char> buffer(offsets.end);
+    const auto put = [&buffer](std::size_t offset, auto array) {
+        std::memcpy(buffer.data() + offset, array.data(), array.size_bytes());
+    };
+    put(offsets.kinds, layout.kinds);
+    put(offsets.ops, layout.ops);
+    put(offsets.first, layout.first);
+    put(offsets.second, layout.second);
+    put(offsets.children, layout.children);
+    put(offsets.name_offsets, layout.name_offsets);
+    put(offsets.names, std::span{layout.names});
+
+    header.payload_hash = hash_bytes(buffer.data() + sizeof(Header),
+                                     buffer.size() - sizeof(Header));
+    std::memcpy(buffer.data(), &header, sizeof(header));
+
+    const auto path = entry_path(key);
+    auto temporary = path;
+    temporary += ".tmp" + std::to_string(getpid());
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(buffer.data(), buffer.size());
+        out.close();
+        if (!out) {
+            std::filesystem::remove(temporary);
+            throw std::runtime_error("unable to write " + temporary.string());
+        }
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+} // namespace language
@@ -0,0 +1,144 @@
+#include "purity_analyzer.hpp"
+#include "ast_walker.hpp"
+#include "node.hpp"
+#include <vector>
+
+namespace language {
+
+namespace {
+
+// The function every global variable holds, when it is always the same one.
+class Function_binder final : public AST_walker {
+  private:
+    // Null for a variable assigned anything else.
+    std::vector<Func *> bound_;
+    std::vector<bool> assigned_;
+
+  public:
+    explicit Function_binder(slot_t slot_count)
+        : bound_(slot_count, nullptr), assigned_(slot_count, false) {}
+
+    Func *bound_function(const Variable &variable) const noexcept {
+        return variable.is_local() ? nullptr : bound_[variable.get_slot()];
+    }
+
+    using AST_walker::visit;
+
+    void visit(Assignment_stmt &node) override {
+        bind(*node.get_variable(), dynamic_cast<Func *>(&node.get_value()));
+        AST_walker::visit(node);
+    }
+
+    void visit(Assignment_expr &node) override {
+        bind(*node.get_variable(), dynamic_cast<Func *>(&node.get_value()));
+        AST_walker::visit(node);
+    }
+
+    void visit(Func &node) override {
+        if (auto *name = node.get_name_variable())
+            bind(*name, &node);
+        AST_walker::visit(node);
+    }
+
+  private:
+    void bind(const Variable &variable, Func *func) {
+        if (variable.is_local())
+            return;
+        const auto slot = variable.get_slot();
+        if (!assigned_[slot])
+            bound_[slot] = func;
+        else if (bound_[slot] != func)
+            bound_[slot] = nullptr;
+        assigned_[slot] = true;
+    }
+};
+
+// Checks one function body, leaving the purity of its callees to the caller.
+class Body_checker final : public AST_walker {
+  private:
+    const Function_binder &binder_;
+    std::vector<Func *> callees_;
+    bool pure_ = true;
+
+  public:
+    explicit Body_checker(const Function_binder &binder) : binder_(binder) {}
+
+    bool is_pure() const noexcept { return pure_; }
+    const std::vector<Func *> &get_callees() const noexcept {
+        return callees_;
+    }
+
+    using AST_walker::visit;
+
+    void visit(Input &node) override { pure_ = false; }
+    void visit(Print_stmt &node) override { pure_ = false; }
+    void visit(Func &node) override { pure_ = false; }
+
+    void visit(Variable &node) override {
+        if (!node.is_local())
+            pure_ = false;
+    }
+
+    void visit(Assignment_stmt &node) override {
+        if (!node.get_variable()->is_local())
+            pure_ = false;
+        AST_walker::visit(node);
+    }
+
+    void visit(Assignment_expr &node) override {
+        if (!node.get_variable()->is_local())
+            pure_ = false;
+        AST_walker::visit(node);
+    }
+
+    void visit(Call &node) override {
+        const auto *target = dynamic_cast<Variable *>(&node.get_target());
+        if (auto *callee = target ? binder_.bound_function(*target) : nullptr)
+            callees_.push_back(callee);
+        else
+            pure_ = false;
+
+        for (auto *arg : node.get_args())
+            arg->accept(*this);
+    }
+};
+
+} // namespace
+
+std::size_t mark_pure_functions(Program &program) {
+    Function_binder binder{program.get_slot_count()};
+    program.accept(binder);
+
+    const auto &functions = program.get_functions();
+    std::vector<std::vector<Func *>> callees(functions.size());
+    for (std::size_t i = 0; i < functions.size(); ++i) {
+        Body_checker checker{binder};
+        functions[i]->get_body().accept(checker);
+        functions[i]->set_pure(checker.is_pure());
+        callees[i] = checker.get_callees();
+    }
+
+    // Recursive functions start out pure; a function stops being pure once
+    // one of its callees does.
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (std::size_t i = 0; i < functions.size(); ++i) {
+            if (!functions[i]->is_pure())
+                continue;
+            for (const auto *callee : callees[i]) {
+                if (!callee->is_pure()) {
+                    functions[i]->set_pure(false);
+                    changed = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::size_t pure = 0;
+    for (const auto *func : functions)
+        pure += func->is_pure();
+    return pure;
+}
+
+} // namespace language
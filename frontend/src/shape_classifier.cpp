@@ -0,0 +1,61 @@
+#include "shape_classifier.hpp"
+#include "node.hpp"
+#include <limits>
+
+namespace language {
+
+namespace {
+
+Operand_shape shape_of(Binary_operator &node) {
+    if (!dynamic_cast<Variable *>(&node.get_left()))
+        return Operand_shape::Generic;
+
+    if (dynamic_cast<Number *>(&node.get_right()))
+        return Operand_shape::Var_const;
+    if (dynamic_cast<Variable *>(&node.get_right()))
+        return Operand_shape::Var_var;
+
+    return Operand_shape::Generic;
+}
+
+std::optional<number_t> increment_of(Assignment_stmt &node) {
+    auto *value = dynamic_cast<Binary_operator *>(&node.get_value());
+    if (!value || value->get_shape() != Operand_shape::Var_const)
+        return std::nullopt;
+
+    const auto &left = static_cast<const Variable &>(value->get_left());
+    if (!left.same_storage(*node.get_variable()))
+        return std::nullopt;
+
+    const auto step =
+        static_cast<const Number &>(value->get_right()).get_value();
+    switch (value->get_operator()) {
+    case Binary_operators::Add:
+        return step;
+    case Binary_operators::Sub:
+        if (step == std::numeric_limits<number_t>::min())
+            return std::nullopt;
+        return -step;
+    default:
+        return std::nullopt;
+    }
+}
+
+} // namespace
+
+void Shape_classifier::visit(Assignment_stmt &node) {
+    AST_walker::visit(node);
+    node.set_increment(increment_of(node));
+}
+
+void Shape_classifier::visit(Return_stmt &node) {
+    AST_walker::visit(node);
+    node.set_tail_call(dynamic_cast<Call *>(&node.get_value()));
+}
+
+void Shape_classifier::visit(Binary_operator &node) {
+    AST_walker::visit(node);
+    node.set_shape(shape_of(node));
+}
+
+} // namespace language
@@ -0,0 +1,339 @@
+#include "simd_lexer.hpp"
+#include "parser.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMD_LEXER_VECTOR
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#define SIMD_LEXER_VECTOR
+#endif
+
+namespace language {
+
+namespace {
+
+using token = yy::parser::token;
+
+bool is_whitespace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\r';
+}
+
+bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+bool is_identifier_start(char c) noexcept {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+bool is_identifier(char c) noexcept {
+    return is_identifier_start(c) || is_digit(c);
+}
+
+#ifdef SIMD_LEXER_VECTOR
+
+#if defined(__AVX2__)
+using vec_t = __m256i;
+using mask_t = std::uint32_t;
+constexpr std::size_t vec_size = 32;
+
+vec_t load(const char *p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+vec_t splat(char c) noexcept { return _mm256_set1_epi8(c); }
+vec_t eq(vec_t a, vec_t b) noexcept { return _mm256_cmpeq_epi8(a, b); }
+vec_t gt(vec_t a, vec_t b) noexcept { return _mm256_cmpgt_epi8(a, b); }
+vec_t any(vec_t a, vec_t b) noexcept { return _mm256_or_si256(a, b); }
+vec_t both(vec_t a, vec_t b) noexcept { return _mm256_and_si256(a, b); }
+mask_t bits(vec_t v) noexcept {
+    return static_cast<mask_t>(_mm256_movemask_epi8(v));
+}
+#else
+using vec_t = __m128i;
+using mask_t = std::uint32_t;
+constexpr std::size_t vec_size = 16;
+
+vec_t load(const char *p) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+vec_t splat(char c) noexcept { return _mm_set1_epi8(c); }
+vec_t eq(vec_t a, vec_t b) noexcept { return _mm_cmpeq_epi8(a, b); }
+vec_t gt(vec_t a, vec_t b) noexcept { return _mm_cmpgt_epi8(a, b); }
+vec_t any(vec_t a, vec_t b) noexcept { return _mm_or_si128(a, b); }
+vec_t both(vec_t a, vec_t b) noexcept { return _mm_and_si128(a, b); }
+mask_t bits(vec_t v) noexcept {
+    return static_cast<mask_t>(_mm_movemask_epi8(v));
+}
+#endif
+
+constexpr mask_t all_bits =
+    vec_size == 32 ? ~mask_t{0} : (mask_t{1} << vec_size) - 1;
+
+// Bytes in [low, high]. Compares are signed, which keeps bytes >= 0x80 out
+// of the ASCII ranges used here.
+vec_t in_range(vec_t v, char low, char high) noexcept {
+    return both(gt(v, splat(low - 1)), gt(splat(high + 1), v));
+}
+
+vec_t whitespace_bytes(vec_t v) noexcept {
+    return any(any(eq(v, splat(' ')), in_range(v, '\t', '\v')),
+               eq(v, splat('\r')));
+}
+
+vec_t digit_bytes(vec_t v) noexcept { return in_range(v, '0', '9'); }
+
+vec_t identifier_bytes(vec_t v) noexcept {
+    const vec_t lower = any(v, splat(0x20));
+    return any(any(in_range(lower, 'a', 'z'), digit_bytes(v)),
+               eq(v, splat('_')));
+}
+
+// Length of the longest prefix of [p, end) whose bytes are all in the class.
+template <vec_t (*Vector)(vec_t), bool (*Scalar)(char)>
+std::size_t span(const char *p, const char *end) noexcept {
+    const char *const start = p;
+    for (; end - p >= static_cast<std::ptrdiff_t>(vec_size); p += vec_size) {
+        const mask_t outside = ~bits(Vector(load(p))) & all_bits;
+        if (outside)
+            return p - start + std::countr_zero(outside);
+    }
+    while (p != end && Scalar(*p))
+        ++p;
+    return p - start;
+}
+
+const char *find_byte(const char *p, const char *end, char c) noexcept {
+    const vec_t needle = splat(c);
+    for (; end - p >= static_cast<std::ptrdiff_t>(vec_size); p += vec_size) {
+        if (const mask_t found = bits(eq(load(p), needle)))
+            return p + std::countr_zero(found);
+    }
+    while (p != end && *p != c)
+        ++p;
+    return p;
+}
+
+#else
+
+template <bool (*Scalar)(char)>
+std::size_t scalar_span(const char *p, const char *end) noexcept {
+    const char *const start = p;
+    while (p != end && Scalar(*p))
+        ++p;
+    return p - start;
+}
+
+const char *find_byte(const char *p, const char *end, char c) noexcept {
+    const void *found = std::memchr(p, c, end - p);
+    return found ? static_cast<const char *>(found) : end;
+}
+
+#endif
+
+std::size_t digit_span(const char *p, const char *end) noexcept {
+#ifdef SIMD_LEXER_VECTOR
+    return span<digit_bytes, is_digit>(p, end);
+#else
+    return scalar_span<is_digit>(p, end);
+#endif
+}
+
+std::size_t identifier_span(const char *p, const char *end) noexcept {
+#ifdef SIMD_LEXER_VECTOR
+    return span<identifier_bytes, is_identifier>(p, end);
+#else
+    return scalar_span<is_identifier>(p, end);
+#endif
+}
+
+// End of the "/*" comment starting at p, nullptr when it is not closed.
+const char *block_comment_end(const char *p, const char *end) noexcept {
+    for (const char *star = p + 2;; ++star) {
+        star = find_byte(star, end, '*');
+        if (end - star < 2)
+            return nullptr;
+        if (star[1] == '/')
+            return star + 2;
+    }
+}
+
+int keyword_or_identifier(std::string_view text) noexcept {
+    switch (text.size()) {
+    case 2:
+        if (text == "if")
+            return token::TOK_IF;
+        break;
+    case 4:
+        if (text == "else")
+            return token::TOK_ELSE;
+        if (text == "func")
+            return token::TOK_FUNC;
+        break;
+    case 5:
+        if (text == "while")
+            return token::TOK_WHILE;
+        if (text == "print")
+            return token::TOK_PRINT;
+        break;
+    case 6:
+        if (text == "return")
+            return token::TOK_RETURN;
+        break;
+    }
+    return token::TOK_ID;
+}
+
+} // namespace
+
+const char *Simd_lexer::simd_level() noexcept {
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+int Simd_lexer::token(std::size_t length, int kind) noexcept {
+    token_ = pos_;
+    yyleng_ = static_cast<int>(length);
+    yycolumn += yyleng_;
+    pos_ += length;
+    return kind;
+}
+
+void Simd_lexer::skip_whitespace() noexcept {
+#ifdef SIMD_LEXER_VECTOR
+    // Newlines are counted in the same pass, the column restarts after the
+    // last one.
+    for (; end_ - pos_ >= static_cast<std::ptrdiff_t>(vec_size);
+         pos_ += vec_size) {
+        const vec_t v = load(pos_);
+        const mask_t outside = ~bits(whitespace_bytes(v)) & all_bits;
+        const mask_t run = outside ? (outside - 1) & ~outside : all_bits;
+        const int length = std::popcount(run);
+        const mask_t newlines = bits(eq(v, splat('\n'))) & run;
+
+        if (newlines) {
+            yylineno += std::popcount(newlines);
+            yycolumn = length - (std::bit_width(newlines) - 1);
+        } else {
+            yycolumn += length;
+        }
+        if (outside) {
+            pos_ += length;
+            return;
+        }
+    }
+#endif
+    for (; pos_ != end_ && is_whitespace(*pos_); ++pos_) {
+        if (*pos_ == '\n') {
+            ++yylineno;
+            yycolumn = 1;
+        } else {
+            ++yycolumn;
+        }
+    }
+}
+
+int Simd_lexer::yylex() {
+    for (;;) {
+        skip_whitespace();
+        if (pos_ == end_) {
+            token_ = pos_;
+            yyleng_ = 0;
+            return 0;
+        }
+
+        const char c = *pos_;
+        const std::size_t rest = end_ - pos_;
+        const char next = rest > 1 ? pos_[1] : '\0';
+
+        if (c == '/' && next == '/') {
+            const char *newline = find_byte(pos_, end_, '\n');
+            token_ = pos_;
+            yyleng_ = static_cast<int>(newline - pos_);
+            yycolumn += yyleng_;
+            pos_ = newline;
+            continue;
+        }
+        if (c == '/' && next == '*') {
+            // The Flex rule does not advance the line or the column either.
+            if (const char *comment_end = block_comment_end(pos_, end_)) {
+                token_ = pos_;
+                yyleng_ = static_cast<int>(comment_end - pos_);
+                pos_ = comment_end;
+                continue;
+            }
+        }
+
+        if (is_identifier_start(c)) {
+            const std::size_t length = identifier_span(pos_, end_);
+            return token(length, keyword_or_identifier({pos_, length}));
+        }
+        if (c == '0')
+            return token(1, token::TOK_NUMBER);
+        if (is_digit(c))
+            return token(digit_span(pos_, end_), token::TOK_NUMBER);
+
+        switch (c) {
+        case '|':
+            return next == '|' ? token(2, token::TOK_LOG_OR)
+                               : token(1, token::TOK_OR);
+        case '&':
+            return next == '&' ? token(2, token::TOK_LOG_AND)
+                               : token(1, token::TOK_AND);
+        case '=':
+            return next == '=' ? token(2, token::TOK_EQ)
+                               : token(1, token::TOK_ASSIGN);
+        case '!':
+            return next == '=' ? token(2, token::TOK_NEQ)
+                               : token(1, token::TOK_NOT);
+        case '<':
+            return next == '=' ? token(2, token::TOK_LESS_OR_EQ)
+                               : token(1, token::TOK_LESS);
+        case '>':
+            return next == '=' ? token(2, token::TOK_GREATER_OR_EQ)
+                               : token(1, token::TOK_GREATER);
+        case '?':
+            return token(1, token::TOK_INPUT);
+        case '+':
+            return token(1, token::TOK_PLUS);
+        case '-':
+            return token(1, token::TOK_MINUS);
+        case '*':
+            return token(1, token::TOK_MUL);
+        case '/':
+            return token(1, token::TOK_DIV);
+        case '%':
+            return token(1, token::TOK_REM_DIV);
+        case '^':
+            return token(1, token::TOK_XOR);
+        case '(':
+            return token(1, token::TOK_LEFT_PAREN);
+        case ')':
+            return token(1, token::TOK_RIGHT_PAREN);
+        case '{':
+            return token(1, token::TOK_LEFT_BRACE);
+        case '}':
+            return token(1, token::TOK_RIGHT_BRACE);
+        case ';':
+            return token(1, token::TOK_SEMICOLON);
+        case ',':
+            return token(1, token::TOK_COMMA);
+        case ':':
+            return token(1, token::TOK_COLON);
+        }
+
+        token_ = pos_++;
+        yyleng_ = 1;
+        *errors_ << "Unknown token: '" << c << "' at line " << yylineno
+                 << std::endl;
+        return -1;
+    }
+}
+
+} // namespace language
@@ -1,12 +1,39 @@
 #include "simulator.hpp"
 #include "expr_evaluator.hpp"
 #include "node.hpp"
-#include <iostream>
-#include <unordered_map>
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <sys/resource.h>
 
 namespace language {
 
+namespace {
+
+// Native stack left to the deepest call for the statements it runs.
+constexpr std::size_t native_stack_reserve = std::size_t{256} << 10;
+
+const char *native_stack_limit() {
+    std::size_t size = std::size_t{8} << 20;
+    rlimit limit{};
+    if (getrlimit(RLIMIT_STACK, &limit) == 0 &&
+        limit.rlim_cur != RLIM_INFINITY)
+        size = limit.rlim_cur;
+
+    const auto *here = static_cast<const char *>(__builtin_frame_address(0));
+    return here - (std::max(size, 2 * native_stack_reserve) -
+                   native_stack_reserve);
+}
+
+} // namespace
+
 void Simulator::visit(Program &node) {
+    slots_.assign(node.get_slot_count(), 0);
+    prepare_call_stack(node);
+
     const auto &statements = node.get_stmts();
 
     for (const auto &stmt : statements) {
@@ -19,20 +46,22 @@ void Simulator::visit(Block_stmt &node) {
 
     for (const auto &stmt : statements) {
         stmt->accept(*this);
+        if (returning_)
+            return;
     }
 }
 
 void Simulator::visit(Empty_stmt &node) {};
 
 void Simulator::visit(Assignment_stmt &node) {
-    auto var_name = static_cast<std::string>(node.get_variable()->get_name());
-    const auto &value = evaluate_expression(node.get_value());
-
-    auto it = nametable_.find(var_name);
-    if (it != nametable_.end())
-        it->second = value;
-    else
-        nametable_.emplace(var_name, value);
+    if (const auto step = node.get_increment()) {
+        slot(*node.get_variable()) += *step;
+        return;
+    }
+
+    const auto value = evaluate_expression(node.get_value());
+
+    slot(*node.get_variable()) = value;
 }
 
 void Simulator::visit(If_stmt &node) {
@@ -51,13 +80,24 @@ void Simulator::visit(If_stmt &node) {
 void Simulator::visit(While_stmt &node) {
     while (evaluate_expression(node.get_condition())) {
         node.get_body().accept(*this);
+        if (returning_)
+            return;
     }
 }
 
 void Simulator::visit(Print_stmt &node) {
     auto value = evaluate_expression(node.get_value());
 
-    std::cout << value << '\n';
+    out_.print(value);
+}
+
+void Simulator::visit(Return_stmt &node) {
+    if (auto *call = node.get_tail_call()) {
+        tail_call(*call);
+        return;
+    }
+    return_value_ = evaluate_expression(node.get_value());
+    returning_ = true;
 }
 
 void Simulator::visit(Assignment_expr &node) {}
@@ -70,10 +110,133 @@ void Simulator::visit(Variable &node) {}
 void Simulator::visit(Func &node) {}
 void Simulator::visit(Call &node) {}
 
+number_t Simulator::define(Func &func) {
+    if (auto *name = func.get_name_variable())
+        slot(*name) = func.get_id();
+    return func.get_id();
+}
+
+Func &Simulator::resolve(Call &node) {
+    const auto target = evaluate_expression(node.get_target());
+    if (target < 1 || static_cast<std::size_t>(target) > functions_.size())
+        throw std::runtime_error("called value " + std::to_string(target) +
+                                 " is not a function");
+
+    auto &callee = *functions_[target - 1];
+    const auto n_args = node.get_args().size();
+    if (n_args != callee.get_params().size())
+        throw std::runtime_error(
+            "function takes " + std::to_string(callee.get_params().size()) +
+            " arguments, " + std::to_string(n_args) + " given");
+    return callee;
+}
+
+number_t Simulator::call(Call &node) {
+    auto *callee = &resolve(node);
+    const auto &args = node.get_args();
+
+    if (depth_ == max_depth_)
+        throw std::runtime_error("call depth limit of " +
+                                 std::to_string(max_depth_) + " exceeded");
+    if (static_cast<const char *>(__builtin_frame_address(0)) <
+        native_stack_limit_)
+        throw std::runtime_error("call depth " + std::to_string(depth_) +
+                                 " exhausts the native stack");
+
+    // Arguments are evaluated in the caller's frame, calls among them push
+    // their frames above the new one.
+    number_t *const frame = stack_top_;
+    stack_top_ += callee->get_frame_size();
+    ++depth_;
+    for (std::size_t i = 0; i < args.size(); ++i)
+        frame[i] = evaluate_expression(*args[i]);
+    std::fill(frame + args.size(), stack_top_, 0);
+
+    // The parameters are ordinary locals, so the key is taken before the
+    // body can assign them.
+    std::optional<Memo_table::Key> key;
+    if (memo_ && callee->is_pure() && args.size() <= Memo_table::max_args) {
+        key.emplace(Memo_table::Key{callee->get_id(), {}});
+        std::copy(frame, frame + args.size(), key->args.begin());
+        if (const auto value = memo_->find(*key)) {
+            stack_top_ = frame;
+            --depth_;
+            return *value;
+        }
+    }
+
+    number_t *const caller = frame_;
+    frame_ = frame;
+    for (;;) {
+        callee->get_body().accept(*this);
+        if (!tail_callee_)
+            break;
+        callee = std::exchange(tail_callee_, nullptr);
+        returning_ = false;
+    }
+    frame_ = caller;
+    stack_top_ = frame;
+    --depth_;
+
+    const auto result = returning_ ? return_value_ : 0;
+    returning_ = false;
+    // A tail call from a pure function goes to a pure one, so the result
+    // still depends only on the arguments of this call.
+    if (key)
+        memo_->insert(*key, result);
+    return result;
+}
+
+// Replaces the arguments of the returning call with the new ones and leaves
+// running the callee to call(), so tail recursion takes neither a frame nor
+// native stack.
+void Simulator::tail_call(Call &node) {
+    auto &callee = resolve(node);
+    const auto &args = node.get_args();
+
+    // The arguments may read the current frame, so they are evaluated above
+    // it and copied down once all of them are known.
+    number_t *const values = stack_top_;
+    stack_top_ += args.size();
+    for (std::size_t i = 0; i < args.size(); ++i)
+        values[i] = evaluate_expression(*args[i]);
+    std::copy(values, values + args.size(), frame_);
+
+    stack_top_ = frame_ + callee.get_frame_size();
+    std::fill(frame_ + args.size(), stack_top_, 0);
+    tail_callee_ = &callee;
+    returning_ = true;
+}
+
 number_t Simulator::evaluate_expression(Expression &expression) {
     Expression_evaluator evaluator(*this);
     expression.accept(evaluator);
     return evaluator.get_result();
 }
 
+void Simulator::prepare_call_stack(const Program &program) {
+    functions_ = program.get_functions();
+    if (functions_.empty())
+        return;
+
+    std::size_t max_frame_size = 0;
+    std::size_t max_params = 0;
+    for (const auto *func : functions_) {
+        max_frame_size = std::max<std::size_t>(max_frame_size,
+                                               func->get_frame_size());
+        max_params = std::max(max_params, func->get_params().size());
+    }
+
+    // A call may hold the arguments of a tail call above its frame.
+    const std::size_t frame_words = max_frame_size + max_params;
+    if (frame_words != 0 &&
+        max_depth_ > std::numeric_limits<std::size_t>::max() / frame_words)
+        throw std::runtime_error("call stack of " +
+                                 std::to_string(max_depth_) +
+                                 " calls is too large");
+    stack_.reset(new number_t[max_depth_ * frame_words]);
+    stack_top_ = stack_.get();
+    native_stack_limit_ = native_stack_limit();
+}
+
 } // namespace language
@@ -0,0 +1,74 @@
+#include "source_file.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace language {
+
+Source_file::Source_file(std::string name) : name_(std::move(name)) {
+    const int fd = open(name_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        throw std::runtime_error("Cannot open program file\n");
+
+    struct stat info {};
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0) {
+        map_size_ = static_cast<std::size_t>(info.st_size);
+        map_ = mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map_ == MAP_FAILED)
+            map_ = nullptr;
+    }
+    close(fd);
+
+    if (map_) {
+        madvise(map_, map_size_, MADV_SEQUENTIAL);
+        text_ = std::string_view(static_cast<const char *>(map_), map_size_);
+        return;
+    }
+
+    // Pipes, character devices and empty files.
+    std::ifstream input(name_, std::ios::binary);
+    if (!input)
+        throw std::runtime_error("Cannot open program file\n");
+    contents_.assign(std::istreambuf_iterator<char>(input),
+                     std::istreambuf_iterator<char>());
+    text_ = contents_;
+}
+
+Source_file::~Source_file() {
+    if (map_)
+        munmap(map_, map_size_);
+}
+
+std::string_view Source_file::line(int number) const {
+    if (number < 1)
+        return {};
+    const auto index = static_cast<std::size_t>(number - 1);
+
+    // Extend the index only as far as the requested line.
+    while (line_starts_.size() <= index + 1 && indexed_ < text_.size()) {
+        const void *newline = std::memchr(text_.data() + indexed_, '\n',
+                                          text_.size() - indexed_);
+        if (!newline) {
+            indexed_ = text_.size();
+            break;
+        }
+        indexed_ = static_cast<const char *>(newline) - text_.data() + 1;
+        line_starts_.push_back(indexed_);
+    }
+
+    if (index >= line_starts_.size())
+        return {};
+
+    const std::size_t begin = line_starts_[index];
+    const std::size_t end = index + 1 < line_starts_.size()
+                                ? line_starts_[index + 1] - 1
+                                : text_.size();
+    return text_.substr(begin, end - begin);
+}
+
+} // namespace language
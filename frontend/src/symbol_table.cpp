@@ -0,0 +1,58 @@
+#include "symbol_table.hpp"
+#include <algorithm>
+#include <functional>
+
+namespace language {
+
+symbol_id_t Symbol_table::intern(name_t_sv name) {
+    if ((symbols_.size() + 1) * 2 > buckets_.size())
+        rehash(std::max<std::size_t>(64, buckets_.size() * 2));
+
+    const auto hash = std::hash<name_t_sv>{}(name);
+    auto &bucket = buckets_[probe(name, hash)];
+    if (bucket != no_symbol)
+        return bucket;
+
+    bucket = static_cast<symbol_id_t>(symbols_.size());
+    symbols_.push_back(Symbol{names_.emplace_back(name), hash});
+    return bucket;
+}
+
+std::optional<symbol_id_t>
+Symbol_table::find(name_t_sv name) const noexcept {
+    if (buckets_.empty())
+        return std::nullopt;
+
+    const auto bucket = buckets_[probe(name, std::hash<name_t_sv>{}(name))];
+    if (bucket == no_symbol)
+        return std::nullopt;
+    return bucket;
+}
+
+// Index of the bucket holding `name`, or of the empty bucket where it
+// belongs.
+std::size_t Symbol_table::probe(name_t_sv name,
+                                std::size_t hash) const noexcept {
+    const auto mask = buckets_.size() - 1;
+    for (auto index = hash & mask;; index = (index + 1) & mask) {
+        const auto symbol = buckets_[index];
+        if (symbol == no_symbol)
+            return index;
+        if (symbols_[symbol].hash == hash && symbols_[symbol].name == name)
+            return index;
+    }
+}
+
+void Symbol_table::rehash(std::size_t bucket_count) {
+    buckets_.assign(bucket_count, no_symbol);
+
+    const auto mask = bucket_count - 1;
+    for (symbol_id_t symbol = 0; symbol < symbols_.size(); ++symbol) {
+        auto index = symbols_[symbol].hash & mask;
+        while (buckets_[index] != no_symbol)
+            index = (index + 1) & mask;
+        buckets_[index] = symbol;
+    }
+}
+
+} // namespace language
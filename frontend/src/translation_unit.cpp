@@ -0,0 +1,26 @@
+#include "translation_unit.hpp"
+#include <utility>
+
+namespace language {
+
+#ifdef SIMD_LEXER
+Translation_unit::Translation_unit(std::string program_file,
+                                   std::ostream &lexer_errors,
+                                   bool use_huge_pages)
+    : source_(std::move(program_file)), scanner_(source_.text()),
+      parser_(&scanner_, source_, use_huge_pages) {
+    scanner_.set_error_stream(lexer_errors);
+}
+#else
+Translation_unit::Translation_unit(std::string program_file,
+                                   std::ostream &lexer_errors,
+                                   bool use_huge_pages)
+    : source_(std::move(program_file)), source_buffer_(source_.text()),
+      program_stream_(&source_buffer_),
+      scanner_(&program_stream_, &lexer_errors, source_.text()),
+      parser_(&scanner_, source_, use_huge_pages) {
+    scanner_.set_error_stream(lexer_errors);
+}
+#endif
+
+} // namespace language
@@ -0,0 +1,131 @@
+#include "vm.hpp"
+
+#if defined(__GNUC__) || defined(__clang__)
+#define VM_COMPUTED_GOTO
+#endif
+
+namespace language {
+
+Vm::Vm(const Bytecode &bytecode, Output_sink &out, Input_reader &in)
+    : bytecode_(bytecode), variables_(bytecode.n_variables),
+      stack_(bytecode.max_stack_depth + 1), out_(out), in_(in) {}
+
+void Vm::run() {
+    const Instruction *const code = bytecode_.code.data();
+    const Instruction *ip = code;
+    number_t *const vars = variables_.data();
+    number_t *sp = stack_.data();
+
+#ifdef VM_COMPUTED_GOTO
+    // Must follow the order of the Opcode enumeration.
+    static void *const dispatch_table[] = {
+        &&L_Push_const, &&L_Load,      &&L_Store,         &&L_Store_keep,
+        &&L_Pop,        &&L_Input,     &&L_Print,         &&L_Eq,
+        &&L_Neq,        &&L_Less,      &&L_LessEq,        &&L_Greater,
+        &&L_GreaterEq,  &&L_Add,       &&L_Sub,           &&L_Mul,
+        &&L_Div,        &&L_RemDiv,    &&L_And,           &&L_Xor,
+        &&L_Or,         &&L_LogOr,     &&L_LogAnd,        &&L_Neg,
+        &&L_Not,        &&L_Jump,      &&L_Jump_if_false, &&L_Jump_if_true,
+        &&L_Halt,
+    };
+#define VM_CASE(name) L_##name
+#define VM_DISPATCH() goto *dispatch_table[static_cast<int>(ip->op)]
+    VM_DISPATCH();
+#else
+#define VM_CASE(name) case Opcode::name
+#define VM_DISPATCH() continue
+    for (;;)
+        switch (ip->op) {
+#endif
+
+#define VM_NEXT()                                                              \
+    ++ip;                                                                      \
+    VM_DISPATCH()
+
+#define VM_BINARY(name, expr)                                                  \
+    VM_CASE(name) : {                                                          \
+        const number_t rhs = *sp--;                                            \
+        const number_t lhs = *sp;                                              \
+        *sp = (expr);                                                          \
+        VM_NEXT();                                                             \
+    }
+
+    VM_CASE(Push_const) : {
+        *++sp = ip->arg;
+        VM_NEXT();
+    }
+    VM_CASE(Load) : {
+        *++sp = vars[ip->arg];
+        VM_NEXT();
+    }
+    VM_CASE(Store) : {
+        vars[ip->arg] = *sp--;
+        VM_NEXT();
+    }
+    VM_CASE(Store_keep) : {
+        vars[ip->arg] = *sp;
+        VM_NEXT();
+    }
+    VM_CASE(Pop) : {
+        --sp;
+        VM_NEXT();
+    }
+    VM_CASE(Input) : {
+        *++sp = in_.read_number();
+        VM_NEXT();
+    }
+    VM_CASE(Print) : {
+        out_.print(*sp--);
+        VM_NEXT();
+    }
+
+    VM_BINARY(Eq, lhs == rhs)
+    VM_BINARY(Neq, lhs != rhs)
+    VM_BINARY(Less, lhs < rhs)
+    VM_BINARY(LessEq, lhs <= rhs)
+    VM_BINARY(Greater, lhs > rhs)
+    VM_BINARY(GreaterEq, lhs >= rhs)
+    VM_BINARY(Add, lhs + rhs)
+    VM_BINARY(Sub, lhs - rhs)
+    VM_BINARY(Mul, lhs * rhs)
+    VM_BINARY(Div, lhs / rhs)
+    VM_BINARY(RemDiv, lhs % rhs)
+    VM_BINARY(And, lhs & rhs)
+    VM_BINARY(Xor, lhs ^ rhs)
+    VM_BINARY(Or, lhs | rhs)
+    VM_BINARY(LogOr, lhs || rhs)
+    VM_BINARY(LogAnd, lhs && rhs)
+
+    VM_CASE(Neg) : {
+        *sp = -*sp;
+        VM_NEXT();
+    }
+    VM_CASE(Not) : {
+        *sp = !*sp;
+        VM_NEXT();
+    }
+    VM_CASE(Jump) : {
+        ip = code + ip->arg;
+        VM_DISPATCH();
+    }
+    VM_CASE(Jump_if_false) : {
+        ip = *sp-- ? ip + 1 : code + ip->arg;
+        VM_DISPATCH();
+    }
+    VM_CASE(Jump_if_true) : {
+        ip = *sp-- ? code + ip->arg : ip + 1;
+        VM_DISPATCH();
+    }
+    VM_CASE(Halt) : { return; }
+
+#ifndef VM_COMPUTED_GOTO
+        }
+#endif
+
+#undef VM_BINARY
+#undef VM_NEXT
+#undef VM_DISPATCH
+#undef VM_CASE
+}
+
+} // namespace language
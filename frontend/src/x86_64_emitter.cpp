@@ -0,0 +1,211 @@
+#include "x86_64_emitter.hpp"
+#include <cstring>
+
+namespace language {
+
+namespace {
+
+// ModRM byte for "eax, [rbx + disp32]" and the "/digit" of group 1 opcodes.
+constexpr std::uint8_t modrm_eax_rbx_disp32 = 0x83;
+
+std::uint8_t alu_digit(X86_64_emitter::Alu op) {
+    switch (op) {
+    case X86_64_emitter::Alu::Add:
+        return 0;
+    case X86_64_emitter::Alu::Or:
+        return 1;
+    case X86_64_emitter::Alu::And:
+        return 4;
+    case X86_64_emitter::Alu::Sub:
+        return 5;
+    case X86_64_emitter::Alu::Xor:
+        return 6;
+    case X86_64_emitter::Alu::Cmp:
+        return 7;
+    }
+    return 0;
+}
+
+std::uint8_t setcc_opcode(X86_64_emitter::Condition cond) {
+    switch (cond) {
+    case X86_64_emitter::Condition::Eq:
+        return 0x94;
+    case X86_64_emitter::Condition::Neq:
+        return 0x95;
+    case X86_64_emitter::Condition::Less:
+        return 0x9C;
+    case X86_64_emitter::Condition::LessEq:
+        return 0x9E;
+    case X86_64_emitter::Condition::Greater:
+        return 0x9F;
+    case X86_64_emitter::Condition::GreaterEq:
+        return 0x9D;
+    }
+    return 0x94;
+}
+
+std::uint32_t slot_offset(slot_t slot) {
+    return static_cast<std::uint32_t>(slot * sizeof(number_t));
+}
+
+} // namespace
+
+X86_64_emitter::label_t X86_64_emitter::prologue() {
+    emit({0x53});             // push rbx
+    emit({0x41, 0x54});       // push r12
+    emit({0x55});             // push rbp
+    emit({0x48, 0x89, 0xFB}); // mov rbx, rdi
+    emit({0x49, 0x89, 0xF4}); // mov r12, rsi
+    emit({0x48, 0x81, 0xEC}); // sub rsp, imm32
+    const auto frame_patch = here();
+    emit_imm32(0);
+    return frame_patch;
+}
+
+void X86_64_emitter::epilogue(label_t frame_patch, std::int32_t frame_size) {
+    patch_imm32(frame_patch, frame_size);
+
+    emit({0x48, 0x81, 0xC4}); // add rsp, imm32
+    emit_imm32(frame_size);
+    emit({0x5D});       // pop rbp
+    emit({0x41, 0x5C}); // pop r12
+    emit({0x5B});       // pop rbx
+    emit({0xC3});       // ret
+}
+
+void X86_64_emitter::mov_eax_imm(number_t value) {
+    emit({0xB8});
+    emit_imm32(value);
+}
+
+void X86_64_emitter::load_slot(slot_t slot) {
+    emit({0x8B, modrm_eax_rbx_disp32});
+    emit_imm32(slot_offset(slot));
+}
+
+void X86_64_emitter::store_slot(slot_t slot) {
+    emit({0x89, modrm_eax_rbx_disp32});
+    emit_imm32(slot_offset(slot));
+}
+
+void X86_64_emitter::load_temp(std::size_t depth) {
+    emit({0x8B, 0x84, 0x24}); // mov eax, [rsp + disp32]
+    emit_imm32(depth * 8);
+}
+
+void X86_64_emitter::store_temp(std::size_t depth) {
+    emit({0x89, 0x84, 0x24}); // mov [rsp + disp32], eax
+    emit_imm32(depth * 8);
+}
+
+void X86_64_emitter::mov_ecx_eax() { emit({0x89, 0xC1}); }
+void X86_64_emitter::mov_eax_ecx() { emit({0x89, 0xC8}); }
+
+void X86_64_emitter::alu_ecx(Alu op) {
+    // op r/m32, r32 with the opcode 8 * digit + 1
+    emit({static_cast<std::uint8_t>(alu_digit(op) * 8 + 1), 0xC8});
+}
+
+void X86_64_emitter::alu_imm(Alu op, number_t value) {
+    emit({0x81, static_cast<std::uint8_t>(0xC0 | alu_digit(op) << 3)});
+    emit_imm32(value);
+}
+
+void X86_64_emitter::alu_slot(Alu op, slot_t slot) {
+    // op r32, r/m32 with the opcode 8 * digit + 3
+    emit({static_cast<std::uint8_t>(alu_digit(op) * 8 + 3),
+          modrm_eax_rbx_disp32});
+    emit_imm32(slot_offset(slot));
+}
+
+void X86_64_emitter::imul_ecx() { emit({0x0F, 0xAF, 0xC1}); }
+
+void X86_64_emitter::imul_imm(number_t value) {
+    emit({0x69, 0xC0});
+    emit_imm32(value);
+}
+
+void X86_64_emitter::imul_slot(slot_t slot) {
+    emit({0x0F, 0xAF, modrm_eax_rbx_disp32});
+    emit_imm32(slot_offset(slot));
+}
+
+void X86_64_emitter::idiv_ecx() {
+    emit({0x99});       // cdq
+    emit({0xF7, 0xF9}); // idiv ecx
+}
+
+void X86_64_emitter::mov_eax_edx() { emit({0x89, 0xD0}); }
+void X86_64_emitter::neg_eax() { emit({0xF7, 0xD8}); }
+
+void X86_64_emitter::test_eax() { emit({0x85, 0xC0}); }
+void X86_64_emitter::test_ecx() { emit({0x85, 0xC9}); }
+
+void X86_64_emitter::setcc_eax(Condition cond) {
+    emit({0x0F, setcc_opcode(cond), 0xC0});
+}
+
+void X86_64_emitter::setcc_ecx(Condition cond) {
+    emit({0x0F, setcc_opcode(cond), 0xC1});
+}
+
+void X86_64_emitter::and_al_cl() { emit({0x20, 0xC8}); }
+void X86_64_emitter::or_al_cl() { emit({0x08, 0xC8}); }
+void X86_64_emitter::movzx_eax_al() { emit({0x0F, 0xB6, 0xC0}); }
+
+void X86_64_emitter::call_helper(const void *helper, bool pass_eax) {
+    if (pass_eax)
+        emit({0x89, 0xC6}); // mov esi, eax
+    emit({0x4C, 0x89, 0xE7}); // mov rdi, r12
+    emit({0x48, 0xB8});       // mov rax, imm64
+    emit_imm64(reinterpret_cast<std::uintptr_t>(helper));
+    emit({0xFF, 0xD0}); // call rax
+}
+
+X86_64_emitter::label_t X86_64_emitter::jmp() {
+    emit({0xE9});
+    const auto at = here();
+    emit_imm32(0);
+    return at;
+}
+
+X86_64_emitter::label_t X86_64_emitter::jz() {
+    emit({0x0F, 0x84});
+    const auto at = here();
+    emit_imm32(0);
+    return at;
+}
+
+X86_64_emitter::label_t X86_64_emitter::jnz() {
+    emit({0x0F, 0x85});
+    const auto at = here();
+    emit_imm32(0);
+    return at;
+}
+
+void X86_64_emitter::patch_jump(label_t jump, label_t target) {
+    const auto rel = static_cast<std::int64_t>(target) -
+                     static_cast<std::int64_t>(jump + sizeof(std::uint32_t));
+    patch_imm32(jump, static_cast<std::uint32_t>(rel));
+}
+
+void X86_64_emitter::emit(std::initializer_list<std::uint8_t> bytes) {
+    code_.insert(code_.end(), bytes);
+}
+
+void X86_64_emitter::emit_imm32(std::uint32_t value) {
+    for (int i = 0; i < 4; ++i)
+        code_.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+}
+
+void X86_64_emitter::emit_imm64(std::uint64_t value) {
+    for (int i = 0; i < 8; ++i)
+        code_.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+}
+
+void X86_64_emitter::patch_imm32(std::size_t at, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i)
+        code_[at + i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+} // namespace language
@@ -0,0 +1,37 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+GOOD="$TEST_DIR/correct_program_tests"
+BAD="$TEST_DIR/tests_that_do_not_compile"
+
+files=("$BAD/syntax_error.txt" "$GOOD/fibbonachi.txt" "$TEST_DIR/test_check/missing.txt"
+       "$GOOD/nested_if_else.txt" "$BAD/local_variables_error.txt")
+
+expected="FAILED: $BAD/syntax_error.txt:3:6: error: syntax error, unexpected identifier, expecting =
+	prin bar;
+	     ^^^
+$TEST_DIR/test_check/missing.txt: error: Cannot open program file
+FAILED: $BAD/local_variables_error.txt:12:7: error: 'b' was not declared in this scope
+	print b * 2;
+	      ^"
+
+# Diagnostics come in the order of the files, whatever the thread count.
+serial=$("$PROGRAM" --check --jobs=1 "${files[@]}" 2>/dev/null)
+serial_status=$?
+parallel=$("$PROGRAM" --check --jobs=4 "${files[@]}" 2>/dev/null)
+summary=$("$PROGRAM" --check --jobs=4 "${files[@]}" 2>&1 >/dev/null)
+
+"$PROGRAM" --check "$GOOD/fibbonachi.txt" "$GOOD/nested_if_else.txt" >/dev/null 2>&1
+good_status=$?
+
+if [ "$serial" = "$parallel" ] && [ "$serial_status" -ne 0 ] &&
+   [ "$good_status" -eq 0 ] &&
+   [ "$summary" = "error: 3 of 5 programs failed to compile" ] &&
+   [ "$serial" = "$expected" ]; then
+  echo "test_check success"
+  exit 0
+else
+  echo "test_check fail"
+  exit 1
+fi
@@ -0,0 +1,21 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+
+out=$(printf "9\n" | "$PROGRAM" --engine=closure "$TEST_DIR/test_fibonachi/fibonachi.txt")
+out="$out $("$PROGRAM" --engine=closure "$TEST_DIR/test_tuple_assign/tuple_assign.txt")"
+out="$out $(printf "1 4 0\n" | "$PROGRAM" --engine=closure "$TEST_DIR/test_input_in_condition/input_in_condition.txt")"
+
+# Operands are evaluated left to right even when one assigns the other.
+out="$out $(printf "x = 1;\ny = x + (x = 5);\nprint y;\nz = (x = 2) + x;\nprint z;\n" | "$PROGRAM" --engine=closure /dev/stdin)"
+
+norm=$(printf "%s" "$out" | tr -s '[:space:]' ' ' | sed 's/^ //; s/ $//')
+
+if [ "$norm" = "34 999 5 -5 8 8 10 10 6 4" ]; then
+  echo "test_closure_engine success"
+  exit 0
+else
+  echo "test_closure_engine fail"
+  exit 1
+fi
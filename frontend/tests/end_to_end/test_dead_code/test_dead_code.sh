@@ -0,0 +1,20 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+
+out=$(printf "5 6\n" | "$PROGRAM" -O --opt-stats "$TEST_DIR/test_dead_code/dead_code.txt" 2>/dev/null)
+status=$?
+stats=$(printf "5 6\n" | "$PROGRAM" -O --opt-stats "$TEST_DIR/test_dead_code/dead_code.txt" 2>&1 >/dev/null)
+
+norm=$(printf "%s" "$out" | tr -s '[:space:]' ' ' | sed 's/^ //; s/ $//')
+
+# y = n / 0 must still trap after k is folded to 10.
+if [ "$norm" = "1 13" ] && [ $status -ne 0 ] &&
+   [[ "$stats" =~ ^optimizer:\ [0-9]+\ expressions\ folded,\ [1-9][0-9]*\ nodes\ removed, ]]; then
+  echo "test_dead_code success"
+  exit 0
+else
+  echo "test_dead_code fail"
+  exit 1
+fi
@@ -0,0 +1,35 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+PROGRAM_FILE="$TEST_DIR/tests_that_do_not_compile/several_errors.txt"
+
+expected="FAILED: $PROGRAM_FILE:12:7: error: 'b' was not declared in this scope
+	print b * 2;
+	      ^
+$PROGRAM_FILE:14:10: error: 's' was not declared in this scope
+	s = (b = s);
+	         ^"
+
+out=$("$PROGRAM" "$PROGRAM_FILE" 2>/dev/null)
+
+# Sources that cannot be mapped are read into memory instead.
+piped=$(printf "a = 1;\nb = ;\n" | "$PROGRAM" /dev/stdin 2>/dev/null)
+expected_piped="FAILED: /dev/stdin:2:5: error: syntax error, unexpected ;
+	b = ;
+	    ^"
+
+RANGE_FILE="$TEST_DIR/tests_that_do_not_compile/number_out_of_range.txt"
+range=$("$PROGRAM" "$RANGE_FILE" 2>/dev/null)
+expected_range="FAILED: $RANGE_FILE:2:10: error: integer literal '99999999999999999999' is out of range
+	bigger = 99999999999999999999 + 1;
+	         ^^^^^^^^^^^^^^^^^^^^"
+
+if [ "$out" = "$expected" ] && [ "$piped" = "$expected_piped" ] &&
+   [ "$range" = "$expected_range" ]; then
+  echo "test_diagnostics success"
+  exit 0
+else
+  echo "test_diagnostics fail"
+  exit 1
+fi
@@ -0,0 +1,45 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+HEAT="$TEST_DIR/test_dump_heat/dump_heat.txt"
+
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+export DUMP_DIR="$WORK/dump"
+GV="$DUMP_DIR/dump.gv"
+
+# Only builds with GRAPH_DUMP write the graph.
+"$PROGRAM" --dump-heat=count "$HEAT" >/dev/null 2>&1
+if [ ! -f "$GV" ]; then
+  echo "test_dump_heat success (skipped, built without GRAPH_DUMP)"
+  exit 0
+fi
+
+# Prints the run counts of the nodes with the given title, in dump order.
+runs() {
+  sed -n "s/.*label=\"{ $1 | .*| runs: \([^|]*\) |.*/\1/p" "$GV" | tr '\n' ','
+}
+
+ok=1
+
+[ "$(runs While)" = "1," ] || ok=0
+# The loop condition is counted, its operands inherit the count.
+[ "$(runs 'Binary operator')" = "101,100,≤100 (inherited)," ] || ok=0
+[ "$(runs If)" = "100," ] || ok=0
+[ "$(runs Print)" = "0," ] || ok=0
+[ "$(runs Assignment)" = "1,100," ] || ok=0
+grep -q 'lightgrey' "$GV" || ok=0
+
+"$PROGRAM" --dump-heat=count --dump-prune "$HEAT" >/dev/null 2>&1
+[ "$(runs Print)" = "" ] || ok=0
+[ "$(runs If)" = "100," ] || ok=0
+grep -q 'lightgrey' "$GV" && ok=0
+
+if [ $ok -eq 1 ]; then
+  echo "test_dump_heat success"
+  exit 0
+else
+  echo "test_dump_heat fail"
+  exit 1
+fi
@@ -0,0 +1,72 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+FUNCTIONS="$TEST_DIR/test_functions/functions.txt"
+DEEP="$TEST_DIR/test_functions/deep.txt"
+ERRORS="$TEST_DIR/tests_that_do_not_compile/function_errors.txt"
+
+expected="3628800 6765 7 15 15 0 15 1 1 6 24 120 71"
+
+normalize() {
+  tr -s '[:space:]' ' ' | sed 's/^ //; s/ $//'
+}
+
+ok=1
+
+# Engines without function support fall back to the Simulator.
+for args in "" "-O" "--engine=vm" "--engine=flat" "--engine=closure" \
+            "--engine=jit"; do
+  out=$("$PROGRAM" $args "$FUNCTIONS" 2>/dev/null | normalize)
+  if [ "$out" != "$expected" ]; then
+    echo "output with '$args': $out"
+    ok=0
+  fi
+done
+
+# A local and a global with the same slot number are different variables, so
+# neither assignment is an increment of the variable it assigns.
+SHADOW="g = 100;\nf = func() : h { x = g + 1; return x; };\nprint f();\n"
+GLOBAL="g = 100;\nf = func(a) : h { g = a + 1; return g; };\nprint f(5);\n"
+for args in "" "-O"; do
+  out=$(printf "$SHADOW" | "$PROGRAM" $args /dev/stdin 2>&1 | normalize)
+  [ "$out" = "101" ] || ok=0
+  out=$(printf "${GLOBAL}print g;\n" | "$PROGRAM" $args /dev/stdin 2>&1 |
+        normalize)
+  [ "$out" = "6 6" ] || ok=0
+done
+
+deep=$(printf "5000\n" | "$PROGRAM" "$DEEP" 2>/dev/null | normalize)
+[ "$deep" = "5000" ] || ok=0
+
+limited=$(printf "5000\n" | "$PROGRAM" --max-call-depth=100 "$DEEP" 2>&1)
+[ $? -eq 1 ] || ok=0
+[ "$limited" = "error: call depth limit of 100 exceeded" ] || ok=0
+
+too_deep=$("$PROGRAM" --max-call-depth=9223372036854775808 "$DEEP" 2>&1)
+[ $? -eq 1 ] || ok=0
+[ "$too_deep" = "error: --max-call-depth is at most 1000000" ] || ok=0
+
+not_func=$(printf "f = 3;\nx = f(1);\n" | "$PROGRAM" /dev/stdin 2>&1)
+[ "$not_func" = "error: called value 3 is not a function" ] || ok=0
+
+arity=$(printf "f = func(a) { return a; };\nx = f(1, 2);\n" |
+        "$PROGRAM" /dev/stdin 2>&1)
+[ "$arity" = "error: function takes 1 arguments, 2 given" ] || ok=0
+
+errors=$("$PROGRAM" "$ERRORS" 2>/dev/null)
+expected_errors="FAILED: $ERRORS:1:13: error: duplicate parameter 'a'
+	f = func(a, a) { return a; };
+	            ^
+$ERRORS:2:1: error: 'return' outside of a function
+	return 1;
+	^^^^^^"
+[ "$errors" = "$expected_errors" ] || ok=0
+
+if [ $ok -eq 1 ]; then
+  echo "test_functions success"
+  exit 0
+else
+  echo "test_functions fail"
+  exit 1
+fi
@@ -0,0 +1,35 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end/test_input_reader"
+
+status=0
+check() {
+  if [ "$2" != "$3" ]; then
+    echo "$1: expected '$3', got '$2'"
+    status=1
+  fi
+}
+
+# Regular file (mapped), pipe (block reads) and --input must agree.
+check "file" "$("$PROGRAM" "$TEST_DIR/sum.txt" < "$TEST_DIR/sum.in")" "-2147483635"
+check "pipe" "$(cat "$TEST_DIR/sum.in" | "$PROGRAM" "$TEST_DIR/sum.txt")" "-2147483635"
+check "--input" "$("$PROGRAM" --input "$TEST_DIR/sum.in" "$TEST_DIR/sum.txt" < /dev/null)" "-2147483635"
+
+check "eof" "$(printf "3 1 2" | "$PROGRAM" "$TEST_DIR/sum.txt" 2>&1; echo "rc=$?")" \
+  "error: input value 4: unexpected end of input
+rc=1"
+check "malformed" "$(printf "2 1 2x" | "$PROGRAM" --engine=vm "$TEST_DIR/sum.txt" 2>&1; echo "rc=$?")" \
+  "error: input value 3: malformed number '2x'
+rc=1"
+check "range" "$(printf "1 2147483648" | "$PROGRAM" --engine=jit "$TEST_DIR/sum.txt" 2>&1; echo "rc=$?")" \
+  "error: input value 2: number out of range '2147483648'
+rc=1"
+
+if [ $status -eq 0 ]; then
+  echo "test_input_reader success"
+  exit 0
+else
+  echo "test_input_reader fail"
+  exit 1
+fi
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+
+# Nothing is read or printed, only the lexer report goes to stderr.
+out=$(printf "" | "$PROGRAM" --lex-only "$TEST_DIR/test_lex_only/lex_only.txt" 2>/dev/null)
+status=$?
+stats=$(printf "" | "$PROGRAM" --lex-only "$TEST_DIR/test_lex_only/lex_only.txt" 2>&1 >/dev/null)
+
+if [ -z "$out" ] && [ $status -eq 0 ] &&
+   [[ "$stats" =~ ^lexer\ \([a-z0-9]+\):\ 21\ tokens,\ 131\ bytes\ in\ .*\ GB/s$ ]]; then
+  echo "test_lex_only success"
+  exit 0
+else
+  echo "test_lex_only fail"
+  exit 1
+fi
@@ -0,0 +1,21 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+
+# With d = 0 the loop dividing by d never runs and must not trap.
+out=$(printf "3 4 0\n" | "$PROGRAM" -O "$TEST_DIR/test_loop_invariant/loop_invariant.txt")
+status=$?
+out="$out $(printf "3 4 2\n" | "$PROGRAM" -O "$TEST_DIR/test_loop_invariant/loop_invariant.txt")"
+stats=$(printf "3 4 0\n" | "$PROGRAM" -O --opt-stats "$TEST_DIR/test_loop_invariant/loop_invariant.txt" 2>&1 >/dev/null)
+
+norm=$(printf "%s" "$out" | tr -s '[:space:]' ' ' | sed 's/^ //; s/ $//')
+
+if [ "$norm" = "515 0 515 1 1 2" ] && [ $status -eq 0 ] &&
+   [[ "$stats" =~ \ [1-9][0-9]*\ loop\ invariants\ hoisted$ ]]; then
+  echo "test_loop_invariant success"
+  exit 0
+else
+  echo "test_loop_invariant fail"
+  exit 1
+fi
@@ -0,0 +1,32 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_PATH="../frontend/tests/end_to_end/test_memoization/memoization.txt"
+
+normalize() {
+  tr -s '[:space:]' ' ' | sed 's/^ //; s/ $//'
+}
+
+ok=1
+
+# Exponential without the memo table.
+out=$(printf "40 16\n" | timeout 10 "$PROGRAM" --memo-stats "$TEST_PATH" \
+      2>stats.txt | normalize)
+[ "$out" = "102334155 76183 4 5 2 1 2 1" ] || ok=0
+grep -q "^memo: 2 pure functions, .* hits" stats.txt || ok=0
+
+for args in "--memo-size=0" "--memo-size=1 --memo-eviction=fifo" \
+            "--memo-size=16 --memo-eviction=lru"; do
+  out=$(printf "20 8\n" | "$PROGRAM" $args "$TEST_PATH" | normalize)
+  [ "$out" = "6765 12870 4 5 2 1 2 1" ] || ok=0
+done
+
+rm -f stats.txt
+
+if [ $ok -eq 1 ]; then
+  echo "test_memoization success"
+  exit 0
+else
+  echo "test_memoization fail"
+  exit 1
+fi
@@ -0,0 +1,16 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+
+out=$(printf "5\n" | "$PROGRAM" "$TEST_DIR/test_operand_shapes/operand_shapes.txt")
+
+norm=$(printf "%s" "$out" | tr -s '[:space:]' ' ' | sed 's/^ //; s/ $//')
+
+if [ "$norm" = "4 5 2 15 10 2147483645 -2" ]; then
+  echo "test_operand_shapes success"
+  exit 0
+else
+  echo "test_operand_shapes fail"
+  exit 1
+fi
@@ -0,0 +1,19 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+
+out=$(printf "3\n" | "$PROGRAM" -O "$TEST_DIR/test_optimizer/optimizer.txt")
+
+"$PROGRAM" -O "$TEST_DIR/test_optimizer/division_by_zero.txt" > /dev/null 2>&1
+status=$?
+
+norm=$(printf "%s" "$out" | tr -s '[:space:]' ' ' | sed 's/^ //; s/ $//')
+
+if [ "$norm" = "306 9 14 1 -2147483648 15" ] && [ $status -ne 0 ]; then
+  echo "test_optimizer success"
+  exit 0
+else
+  echo "test_optimizer fail"
+  exit 1
+fi
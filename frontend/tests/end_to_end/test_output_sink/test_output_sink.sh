@@ -0,0 +1,34 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+PROGRAM_FILE="$TEST_DIR/test_output_sink/output_sink.txt"
+
+# The program prints n numbers and then divides by zero, everything printed
+# before the trap must reach the pipe whatever the flush policy is.
+expected=$(seq 0 19999 | awk '{ print $1 * 37 - 50000 }' | md5sum)
+
+status=0
+for flags in "" "--flush=exit" "--flush=line" "--flush=size" \
+             "--flush=size --flush-size=7" "--engine=vm" "--engine=jit"; do
+  out=$(printf "20000\n" | "$PROGRAM" $flags "$PROGRAM_FILE" 2>/dev/null | md5sum)
+  if [ "$out" != "$expected" ]; then
+    echo "output mismatch with flags: $flags"
+    status=1
+  fi
+done
+
+# Write errors are reported instead of being lost.
+printf "1\n" | "$PROGRAM" "$TEST_DIR/test_tuple_assign/tuple_assign.txt" > /dev/full 2>/dev/null
+if [ $? -eq 0 ]; then
+  echo "write error was not reported"
+  status=1
+fi
+
+if [ $status -eq 0 ]; then
+  echo "test_output_sink success"
+  exit 0
+else
+  echo "test_output_sink fail"
+  exit 1
+fi
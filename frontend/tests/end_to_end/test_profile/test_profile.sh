@@ -0,0 +1,39 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_PATH="../frontend/tests/end_to_end/test_profile/profile.txt"
+
+out=$(printf "30\n" | "$PROGRAM" --profile "$TEST_PATH" 2>profile.txt)
+norm=$(printf "%s" "$out" | tr -s '[:space:]' ' ' | sed 's/^ //; s/ $//')
+
+# Times vary between runs, so only the counts and the source are compared.
+listing=$(sed -n '/  source$/,$p' profile.txt | tail -n +2 |
+          awk '{ count = substr($0, 1, 12); gsub(/ /, "", count);
+                 print count "|" substr($0, 27) }')
+expected_listing="1|n = ?;
+1|sum = 0;
+1|i = 0;
+1|while (i < n) {
+30|    if (i % 3 == 0)
+10|        sum = sum + i * i;
+|    else
+20|        sum = sum - 1;
+30|    i = i + 1;
+|}
+1|print sum;
+|
+1|twice = func(k) { return k * 2; };
+1|print twice(sum);"
+
+summary=$(head -n 1 profile.txt | sed 's/ in .*//')
+
+rm -f profile.txt
+
+if [ "$norm" = "2545 5090" ] && [ "$listing" = "$expected_listing" ] &&
+   [ "$summary" = "profile: 98 statements run" ]; then
+  echo "test_profile success"
+  exit 0
+else
+  echo "test_profile fail"
+  exit 1
+fi
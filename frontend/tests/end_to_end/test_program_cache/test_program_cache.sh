@@ -0,0 +1,54 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+FIB="$TEST_DIR/test_fibonachi/fibonachi.txt"
+
+CACHE=$(mktemp -d)
+trap 'rm -rf "$CACHE"' EXIT
+
+# Prints the program output followed by the cache outcome.
+run() {
+  local out
+  out=$(printf "9\n" | "$PROGRAM" --cache-dir="$CACHE" --cache-stats "$@" "$FIB" 2>"$CACHE/log")
+  echo "$out $(sed -n 's/^cache: \(.*\) .*$/\1/p' "$CACHE/log")"
+}
+
+results=()
+results+=("$(run)")
+results+=("$(run)")
+results+=("$(run --engine=flat)")
+results+=("$(run --engine=vm -O)")
+results+=("$(run --engine=closure -O)")
+
+entry=$(ls "$CACHE"/*.ast | grep -v -- '-O.ast')
+
+# A flipped payload byte.
+printf '\x55' | dd of="$entry" bs=1 seek=200 conv=notrunc 2>/dev/null
+results+=("$(run)")
+results+=("$(run --engine=jit)")
+
+# An entry written by another compiler version.
+printf 'X' | dd of="$entry" bs=1 seek=16 conv=notrunc 2>/dev/null
+results+=("$(run --engine=flat)")
+
+truncate -s 10 "$entry"
+results+=("$(run)")
+results+=("$(run)")
+
+# Programs with functions are not stored, which only --cache-stats reports.
+printf 'f = func(a) { return a + 1; };\nprint f(2);\n' > "$CACHE/func.txt"
+func_out=$("$PROGRAM" --cache-dir="$CACHE" "$CACHE/func.txt" 2>&1)
+func_stats=$("$PROGRAM" --cache-dir="$CACHE" --cache-stats "$CACHE/func.txt" 2>&1 >/dev/null)
+results+=("$func_out $(echo "$func_stats" | sed -n 's/^cache: \([a-z ]*\)[ :].*$/\1/p' | tr '\n' ',')")
+
+expected="34 miss|34 hit|34 hit|34 miss|34 hit|34 corrupt entry|34 hit|34 stale entry|34 corrupt entry|34 hit|3 miss,entry not stored,"
+actual=$(IFS='|'; echo "${results[*]}")
+
+if [ "$actual" = "$expected" ]; then
+  echo "test_program_cache success"
+  exit 0
+else
+  echo "test_program_cache fail"
+  exit 1
+fi
@@ -0,0 +1,83 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+GENERATOR="./frontend/program_generator"
+
+# Every phase is timed on a program and on one SCALE times larger. Linear
+# growth takes about SCALE times longer; more than TOLERANCE times that is
+# reported as superlinear.
+SCALE=8
+TOLERANCE=2
+
+WORK=$(mktemp -d)
+trap 'rm -rf "$WORK"' EXIT
+
+# Programs are written to the dump directory only by builds with GRAPH_DUMP.
+export DUMP_DIR="$WORK/dump"
+
+# Prints the best wall-clock time of three runs of a command in microseconds.
+best_time() {
+  local best="" start elapsed
+  for _ in 1 2 3; do
+    start=$(date +%s%N)
+    "$@" >/dev/null 2>&1 || return 1
+    elapsed=$((($(date +%s%N) - start) / 1000))
+    if [ -z "$best" ] || [ "$elapsed" -lt "$best" ]; then
+      best=$elapsed
+    fi
+  done
+  echo "$best"
+}
+
+failed=0
+
+# check <phase> <generator options of the small program> -- <options of the
+# large program> -- <frontend options>
+check() {
+  local phase=$1 small=() large=() flags=()
+  shift
+  while [ "$1" != "--" ]; do small+=("$1"); shift; done
+  shift
+  while [ "$1" != "--" ]; do large+=("$1"); shift; done
+  shift
+  flags=("$@")
+
+  "$GENERATOR" "${small[@]}" > "$WORK/small.txt" &&
+    "$GENERATOR" "${large[@]}" > "$WORK/large.txt" || { failed=1; return; }
+
+  local small_time large_time limit
+  small_time=$(best_time "$PROGRAM" "${flags[@]}" "$WORK/small.txt") &&
+    large_time=$(best_time "$PROGRAM" "${flags[@]}" "$WORK/large.txt") ||
+    { echo "$phase: frontend failed"; failed=1; return; }
+
+  limit=$((small_time * SCALE * TOLERANCE))
+  echo "$phase: ${small_time} us -> ${large_time} us (limit ${limit} us)"
+  if [ "$large_time" -gt "$limit" ]; then
+    echo "$phase: superlinear growth"
+    failed=1
+  fi
+}
+
+check lexing --statements=10000 --variables=10000 -- \
+  --statements=80000 --variables=80000 -- --lex-only
+check parsing --statements=10000 --variables=10000 -- \
+  --statements=80000 --variables=80000 -- --check
+check nesting --statements=2000 --depth=25 -- \
+  --statements=2000 --depth=200 -- --check
+check execution --statements=64 --trip-count=20000 -- \
+  --statements=64 --trip-count=160000 --
+
+"$PROGRAM" "$WORK/small.txt" >/dev/null 2>&1
+if [ -f "$DUMP_DIR/dump.gv" ]; then
+  check graph_dump --statements=1000 -- --statements=8000 --
+else
+  echo "graph_dump: skipped, built without GRAPH_DUMP"
+fi
+
+if [ $failed -eq 0 ]; then
+  echo "test_scaling success"
+  exit 0
+else
+  echo "test_scaling fail"
+  exit 1
+fi
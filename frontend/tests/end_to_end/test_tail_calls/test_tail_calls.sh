@@ -0,0 +1,18 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_PATH="../frontend/tests/end_to_end/test_tail_calls/tail_calls.txt"
+
+# Tail calls reuse the frame of the returning call, so a million of them fit
+# in a call depth of 10.
+out=$(printf "1000000\n" | "$PROGRAM" --max-call-depth=10 "$TEST_PATH")
+
+norm=$(printf "%s" "$out" | tr -s '[:space:]' ' ' | sed 's/^ //; s/ $//')
+
+if [ "$norm" = "1000000 3628800 21 0 1 21" ]; then
+  echo "test_tail_calls success"
+  exit 0
+else
+  echo "test_tail_calls fail"
+  exit 1
+fi
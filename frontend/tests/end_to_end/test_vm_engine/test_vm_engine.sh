@@ -0,0 +1,18 @@
+#!/bin/bash
+
+PROGRAM="./frontend/frontend"
+TEST_DIR="../frontend/tests/end_to_end"
+
+out=$(printf "9\n" | "$PROGRAM" --engine=vm "$TEST_DIR/test_fibonachi/fibonachi.txt")
+out="$out $("$PROGRAM" --engine=vm "$TEST_DIR/test_tuple_assign/tuple_assign.txt")"
+out="$out $(printf "1 4 0\n" | "$PROGRAM" --engine=vm "$TEST_DIR/test_input_in_condition/input_in_condition.txt")"
+
+norm=$(printf "%s" "$out" | tr -s '[:space:]' ' ' | sed 's/^ //; s/ $//')
+
+if [ "$norm" = "34 999 5 -5 8 8 10 10" ]; then
+  echo "test_vm_engine success"
+  exit 0
+else
+  echo "test_vm_engine fail"
+  exit 1
+fi
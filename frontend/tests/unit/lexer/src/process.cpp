@@ -6,8 +6,6 @@
 
 using language::Lexer;
 
-int yyFlexLexer::yywrap() { return 1; }
-
 // if
 TEST(LexerTest, ProcessIfSetsToken) {
     std::istringstream in("");
@@ -38,6 +36,26 @@ TEST(LexerTest, ProcessWhileSetsToken) {
     EXPECT_EQ(token, yy::parser::token::TOK_WHILE);
 }
 
+// func
+TEST(LexerTest, ProcessFuncSetsToken) {
+    std::istringstream in("");
+    std::ostringstream out;
+    Lexer lexer(&in, &out);
+
+    int token = lexer.process_func();
+    EXPECT_EQ(token, yy::parser::token::TOK_FUNC);
+}
+
+// return
+TEST(LexerTest, ProcessReturnSetsToken) {
+    std::istringstream in("");
+    std::ostringstream out;
+    Lexer lexer(&in, &out);
+
+    int token = lexer.process_return();
+    EXPECT_EQ(token, yy::parser::token::TOK_RETURN);
+}
+
 // print
 TEST(LexerTest, ProcessPrintSetsToken) {
     std::istringstream in("");
@@ -238,6 +256,26 @@ TEST(LexerTest, ProcessSemicolonSetsToken) {
     EXPECT_EQ(token, yy::parser::token::TOK_SEMICOLON);
 }
 
+// ,
+TEST(LexerTest, ProcessCommaSetsToken) {
+    std::istringstream in("");
+    std::ostringstream out;
+    Lexer lexer(&in, &out);
+
+    int token = lexer.process_comma();
+    EXPECT_EQ(token, yy::parser::token::TOK_COMMA);
+}
+
+// :
+TEST(LexerTest, ProcessColonSetsToken) {
+    std::istringstream in("");
+    std::ostringstream out;
+    Lexer lexer(&in, &out);
+
+    int token = lexer.process_colon();
+    EXPECT_EQ(token, yy::parser::token::TOK_COLON);
+}
+
 TEST(LexerTest, YyLexIsCallableOnEmptyInput) {
     std::istringstream in("");
     std::ostringstream out;
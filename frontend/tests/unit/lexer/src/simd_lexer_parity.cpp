@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "parser/lexer.hpp"
+#include "parser/simd_lexer.hpp"
+
+using language::Lexer;
+using language::Simd_lexer;
+
+namespace {
+
+struct Token {
+    int kind;
+    std::string text;
+    int line;
+    int column;
+
+    bool operator==(const Token &) const = default;
+};
+
+template <typename Scanner> std::vector<Token> tokenize(Scanner &scanner) {
+    std::vector<Token> tokens;
+    for (;;) {
+        const int kind = scanner.yylex();
+        tokens.push_back({kind, std::string(scanner.get_text()),
+                          scanner.get_line(), scanner.get_column()});
+        if (kind <= 0)
+            return tokens;
+    }
+}
+
+std::vector<Token> flex_tokens(const std::string &source) {
+    std::istringstream in(source);
+    std::ostringstream out;
+    Lexer lexer(&in, &out);
+    auto tokens = tokenize(lexer);
+    // Flex leaves the last matched text in place at the end of input.
+    tokens.back().text.clear();
+    return tokens;
+}
+
+std::vector<Token> simd_tokens(const std::string &source) {
+    Simd_lexer lexer(source);
+    auto tokens = tokenize(lexer);
+    tokens.back().text.clear();
+    return tokens;
+}
+
+void expect_same_tokens(const std::string &source) {
+    const auto expected = flex_tokens(source);
+    const auto actual = simd_tokens(source);
+    ASSERT_EQ(actual.size(), expected.size()) << source;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(actual[i].kind, expected[i].kind) << "token " << i;
+        EXPECT_EQ(actual[i].text, expected[i].text) << "token " << i;
+        EXPECT_EQ(actual[i].line, expected[i].line) << "token " << i;
+        EXPECT_EQ(actual[i].column, expected[i].column) << "token " << i;
+    }
+}
+
+} // namespace
+
+TEST(SimdLexerTest, MatchesFlexOnOperatorsAndKeywords) {
+    expect_same_tokens("if else while print ? iffy elsewhere printer _x1\n"
+                       "func return funcs returned f(a, b) : g\n"
+                       "a || b && c == d != e <= f >= g = h\n"
+                       "! + - * / % & ^ | < > ( ) { } ;");
+}
+
+TEST(SimdLexerTest, MatchesFlexOnNumbers) {
+    expect_same_tokens("0 7 007 1234567890 2147483647 10x");
+}
+
+TEST(SimdLexerTest, MatchesFlexOnComments) {
+    expect_same_tokens("a = 1; // comment until the end of the line\n"
+                       "/* block\n comment */ b = 2;\n"
+                       "/**/ /***/ /* ** / */ c /*/ d */ e\n"
+                       "// last line without a newline");
+    expect_same_tokens("x = 1 /* never closed\n y");
+}
+
+TEST(SimdLexerTest, MatchesFlexAcrossVectorBoundaries) {
+    std::string source;
+    for (int i = 0; i < 40; ++i) {
+        source += std::string(i, ' ') + "\t\r\v" + std::string(i % 3, '\n');
+        source += std::string(i + 1, 'a') + std::to_string(i) + " = ";
+        source += "1" + std::string(i, '0') + ";";
+        source += "//" + std::string(i, '/') + "\n";
+        source += "/*" + std::string(i, '*') + "\n*/";
+    }
+    expect_same_tokens(source);
+}
+
+TEST(SimdLexerTest, ReportsUnknownCharacters) {
+    Simd_lexer lexer("a $ b");
+
+    EXPECT_EQ(lexer.yylex(), yy::parser::token::TOK_ID);
+    EXPECT_EQ(lexer.yylex(), -1);
+    EXPECT_EQ(lexer.get_text(), "$");
+    EXPECT_EQ(lexer.yylex(), yy::parser::token::TOK_ID);
+    EXPECT_EQ(lexer.get_column(), 5);
+    EXPECT_EQ(lexer.yylex(), 0);
+}
@@ -0,0 +1,172 @@
+// Writes synthetic Biba-Boba-Buba programs of a chosen size to stdout, for
+// the scaling tests and for experiments with large inputs.
+//
+// The program assigns `--variables` globals and then runs a loop
+// `--trip-count` times. Its body holds `--statements` assignments of
+// `--expr-size` operands each, in groups of `group_size` nested in
+// `--depth` always taken `if`s. Every value is masked to 16 bits, so no
+// trip count overflows, and the same parameters and `--seed` always give
+// the same program.
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+constexpr std::size_t group_size = 8;
+// Deeper levels are not indented further, which would make the size of the
+// program grow with the square of the depth.
+constexpr std::size_t max_indent = 16;
+constexpr int value_mask = 65535;
+
+struct Parameters final {
+    std::size_t statements = 100;
+    std::size_t depth = 1;
+    std::size_t expr_size = 4;
+    std::size_t variables = 16;
+    std::size_t trip_count = 1;
+    std::uint32_t seed = 1;
+};
+
+std::string usage(const char *program_name) {
+    return std::string("Usage: ") + program_name +
+           " [--statements=<count>] [--depth=<levels>]"
+           " [--expr-size=<operands>] [--variables=<count>]"
+           " [--trip-count=<iterations>] [--seed=<number>]";
+}
+
+std::size_t parse_size(std::string_view value, bool allow_zero = false) {
+    std::size_t size = 0;
+    const auto [end, error] =
+        std::from_chars(value.data(), value.data() + value.size(), size);
+    if (error != std::errc{} || end != value.data() + value.size() ||
+        (size == 0 && !allow_zero))
+        throw std::runtime_error("invalid size: " + std::string(value));
+    return size;
+}
+
+Parameters parse_parameters(int argc, const char **argv) {
+    Parameters parameters;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const auto value = arg.substr(arg.find('=') + 1);
+
+        if (arg.starts_with("--statements=")) {
+            parameters.statements = parse_size(value, true);
+        } else if (arg.starts_with("--depth=")) {
+            parameters.depth = parse_size(value, true);
+        } else if (arg.starts_with("--expr-size=")) {
+            parameters.expr_size = parse_size(value);
+        } else if (arg.starts_with("--variables=")) {
+            parameters.variables = parse_size(value);
+        } else if (arg.starts_with("--trip-count=")) {
+            parameters.trip_count = parse_size(value, true);
+        } else if (arg.starts_with("--seed=")) {
+            parameters.seed =
+                static_cast<std::uint32_t>(parse_size(value, true));
+        } else {
+            throw std::runtime_error("unknown option: " + std::string(arg) +
+                                     '\n' + usage(argv[0]));
+        }
+    }
+
+    return parameters;
+}
+
+class Generator final {
+  private:
+    const Parameters &parameters_;
+    std::ostream &out_;
+    std::mt19937 random_;
+
+  public:
+    Generator(const Parameters &parameters, std::ostream &out)
+        : parameters_(parameters), out_(out), random_(parameters.seed) {}
+
+    void generate() {
+        for (std::size_t i = 0; i < parameters_.variables; ++i)
+            out_ << 'v' << i << " = " << i + 1 << ";\n";
+
+        out_ << "i = 0;\n"
+             << "while (i < " << parameters_.trip_count << ") {\n";
+
+        for (std::size_t done = 0; done < parameters_.statements;
+             done += group_size)
+            group(std::min(group_size, parameters_.statements - done));
+
+        out_ << "    i = i + 1;\n"
+             << "}\n"
+             << "print v0;\n";
+    }
+
+  private:
+    std::size_t pick(std::size_t n) { return random_() % n; }
+
+    void indent(std::size_t level) {
+        for (std::size_t i = 0; i <= std::min(level, max_indent); ++i)
+            out_ << "    ";
+    }
+
+    void group(std::size_t statements) {
+        for (std::size_t level = 0; level < parameters_.depth; ++level) {
+            indent(level);
+            out_ << "if (" << variable() << " >= 0) {\n";
+        }
+
+        for (std::size_t i = 0; i < statements; ++i) {
+            indent(parameters_.depth);
+            assignment();
+        }
+
+        for (std::size_t level = parameters_.depth; level-- > 0;) {
+            indent(level);
+            out_ << "}\n";
+        }
+    }
+
+    void assignment() {
+        static constexpr const char *operators[] = {" + ", " - ", " ^ ",
+                                                    " | ", " & "};
+
+        out_ << variable() << " = (";
+        for (std::size_t i = 0; i < parameters_.expr_size; ++i) {
+            if (i != 0)
+                out_ << operators[pick(std::size(operators))];
+            operand();
+        }
+        out_ << ") & " << value_mask << ";\n";
+    }
+
+    void operand() {
+        if (pick(4) == 0)
+            out_ << pick(value_mask + 1);
+        else
+            out_ << variable();
+    }
+
+    std::string variable() {
+        return 'v' + std::to_string(pick(parameters_.variables));
+    }
+};
+
+} // namespace
+
+int main(int argc, const char *argv[]) {
+    try {
+        const auto parameters = parse_parameters(argc, argv);
+        Generator{parameters, std::cout}.generate();
+    } catch (const std::exception &e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+}